@@ -99,6 +99,9 @@ void UDPBasicBurst::initialize(int stage)
     socket.setOutputGate(gate("udpOut"));
     socket.bind(localPort);
 
+    pacer.initialize(this, par("pacingRate").doubleValue(), par("pacingBurst").longValue());
+    socket.setPacer(&pacer);
+
     const char *destAddrs = par("destAddresses");
     cStringTokenizer tokenizer(destAddrs);
     const char *token;
@@ -159,7 +162,11 @@ cPacket *UDPBasicBurst::createPacket()
 
 void UDPBasicBurst::handleMessage(cMessage *msg)
 {
-    if (msg->isSelfMessage())
+    if (pacer.processTimer(msg))
+    {
+        // the pacer has sent the next batch of packets
+    }
+    else if (msg->isSelfMessage())
     {
         if (stopTime <= 0 || simTime() < stopTime)
         {
@@ -27,6 +27,7 @@
 
 #include "INETDefs.h"
 #include "UDPSocket.h"
+#include "TransmitPacer.h"
 
 
 /**
@@ -42,6 +43,7 @@ class INET_API UDPBasicBurst : public cSimpleModule
 
   protected:
     UDPSocket socket;
+    TransmitPacer pacer;
     int localPort, destPort;
 
     ChooseDestAddrMode chooseDestAddrMode;
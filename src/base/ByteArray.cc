@@ -16,22 +16,171 @@
 #include "ByteArray.h"
 
 
-void ByteArray::setDataFromBuffer(const void *ptr, unsigned int length)
+ByteArray::Chunk *ByteArray::createChunk(char *bytes, unsigned int length)
+{
+    Chunk *chunk = new Chunk;
+    chunk->refCount = 1;
+    chunk->length = length;
+    chunk->bytes = bytes;
+    return chunk;
+}
+
+void ByteArray::releaseChunk(Chunk *chunk)
+{
+    ASSERT(chunk->refCount > 0);
+    if (--chunk->refCount == 0)
+    {
+        delete [] chunk->bytes;
+        delete chunk;
+    }
+}
+
+ByteArray& ByteArray::operator=(const ByteArray& other)
+{
+    if (this == &other) return *this;
+    clean();
+    ByteArray_Base::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void ByteArray::copy(const ByteArray& other)
+{
+    slices = other.slices;
+    dataLength = other.dataLength;
+    for (SliceVector::iterator i = slices.begin(); i != slices.end(); ++i)
+        i->chunk->refCount++;
+}
+
+void ByteArray::clean()
+{
+    for (SliceVector::iterator i = slices.begin(); i != slices.end(); ++i)
+        releaseChunk(i->chunk);
+    slices.clear();
+    dataLength = 0;
+}
+
+void ByteArray::appendSlices(const SliceVector& src, unsigned int srcOffs, unsigned int length)
+{
+    ASSERT(&src != &slices);
+
+    for (SliceVector::const_iterator i = src.begin(); length > 0 && i != src.end(); ++i)
+    {
+        if (srcOffs >= i->length)
+        {
+            srcOffs -= i->length;
+            continue;
+        }
+
+        Slice slice = *i;
+        slice.offset += srcOffs;
+        slice.length -= srcOffs;
+        if (slice.length > length)
+            slice.length = length;
+        srcOffs = 0;
+
+        slice.chunk->refCount++;
+        slices.push_back(slice);
+        dataLength += slice.length;
+        length -= slice.length;
+    }
+    ASSERT(length == 0);
+}
+
+void ByteArray::parsimPack(cCommBuffer *b)
+{
+    ByteArray_Base::parsimPack(b);
+    b->pack(dataLength);
+    for (SliceVector::const_iterator i = slices.begin(); i != slices.end(); ++i)
+        b->pack(i->chunk->bytes + i->offset, i->length);
+}
+
+void ByteArray::parsimUnpack(cCommBuffer *b)
+{
+    ByteArray_Base::parsimUnpack(b);
+    unsigned int length;
+    b->unpack(length);
+    char *buffer = length ? new char[length] : NULL;
+    if (length)
+        b->unpack(buffer, length);
+    assignBuffer(buffer, length);
+}
+
+void ByteArray::setDataArraySize(unsigned int size)
+{
+    if (size < dataLength)
+        truncateData(0, dataLength - size);
+    else if (size > dataLength)
+    {
+        unsigned int length = size - dataLength;
+        char *buffer = new char[length];
+        memset(buffer, 0, length);
+        Slice slice = { createChunk(buffer, length), 0, length };
+        slices.push_back(slice);
+        dataLength = size;
+    }
+}
+
+char ByteArray::getData(unsigned int k) const
+{
+    if (k >= dataLength)
+        throw cRuntimeError("Array of size %d indexed by %d", dataLength, k);
+
+    SliceVector::const_iterator i = slices.begin();
+    while (k >= i->length)
+    {
+        k -= i->length;
+        ++i;
+    }
+    return i->chunk->bytes[i->offset + k];
+}
+
+void ByteArray::setData(unsigned int k, char data)
 {
-    if (length != data_arraysize)
+    if (k >= dataLength)
+        throw cRuntimeError("Array of size %d indexed by %d", dataLength, k);
+
+    SliceVector::iterator i = slices.begin();
+    while (k >= i->length)
     {
-        delete [] data_var;
-        data_var = length ? new char[length] : NULL;
-        data_arraysize = length;
+        k -= i->length;
+        ++i;
     }
+
+    if (i->chunk->refCount > 1)
+    {
+        // copy-on-write: detach this slice from the shared chunk
+        char *buffer = new char[i->length];
+        memcpy(buffer, i->chunk->bytes + i->offset, i->length);
+        releaseChunk(i->chunk);
+        i->chunk = createChunk(buffer, i->length);
+        i->offset = 0;
+    }
+    i->chunk->bytes[i->offset + k] = data;
+}
+
+void ByteArray::setDataFromBuffer(const void *ptr, unsigned int length)
+{
+    char *buffer = NULL;
     if (length)
-        memcpy(data_var, ptr, length);
+    {
+        buffer = new char[length];
+        memcpy(buffer, ptr, length);
+    }
+    assignBuffer(buffer, length);
 }
 
 void ByteArray::setDataFromByteArray(const ByteArray& other, unsigned int srcOffs, unsigned int length)
 {
-    ASSERT(srcOffs+length <= other.data_arraysize);
-    setDataFromBuffer(other.data_var+srcOffs, length);
+    ASSERT(srcOffs+length <= other.dataLength);
+
+    if (&other == this)
+    {
+        truncateData(srcOffs, dataLength - srcOffs - length);
+        return;
+    }
+    clean();
+    appendSlices(other.slices, srcOffs, length);
 }
 
 void ByteArray::addDataFromBuffer(const void *ptr, unsigned int length)
@@ -39,48 +188,95 @@ void ByteArray::addDataFromBuffer(const void *ptr, unsigned int length)
     if (0 == length)
         return;
 
-    unsigned int nlength = data_arraysize + length;
-    char *ndata_var = new char[nlength];
-    if (data_arraysize)
-        memcpy(ndata_var, data_var, data_arraysize);
-    memcpy(ndata_var, data_var + data_arraysize, length);
-    delete [] data_var;
-    data_var = ndata_var;
+    char *buffer = new char[length];
+    memcpy(buffer, ptr, length);
+    Slice slice = { createChunk(buffer, length), 0, length };
+    slices.push_back(slice);
+    dataLength += length;
+}
+
+void ByteArray::addDataFromByteArray(const ByteArray& other, unsigned int srcOffs, unsigned int length)
+{
+    ASSERT(srcOffs+length <= other.dataLength);
+
+    if (&other == this)
+    {
+        SliceVector src = slices;
+        appendSlices(src, srcOffs, length);
+    }
+    else
+        appendSlices(other.slices, srcOffs, length);
 }
 
 unsigned int ByteArray::copyDataToBuffer(void *ptr, unsigned int length, unsigned int srcOffs) const
 {
-    if (srcOffs >= data_arraysize)
+    if (srcOffs >= dataLength)
         return 0;
 
-    if (srcOffs + length > data_arraysize)
-        length = data_arraysize - srcOffs;
-    memcpy(ptr, data_var+srcOffs, length);
+    if (srcOffs + length > dataLength)
+        length = dataLength - srcOffs;
+
+    char *dest = (char *)ptr;
+    unsigned int copied = 0;
+    for (SliceVector::const_iterator i = slices.begin(); copied < length && i != slices.end(); ++i)
+    {
+        if (srcOffs >= i->length)
+        {
+            srcOffs -= i->length;
+            continue;
+        }
+        unsigned int sliceLength = i->length - srcOffs;
+        if (sliceLength > length - copied)
+            sliceLength = length - copied;
+        memcpy(dest + copied, i->chunk->bytes + i->offset + srcOffs, sliceLength);
+        copied += sliceLength;
+        srcOffs = 0;
+    }
+    ASSERT(copied == length);
     return length;
 }
 
 void ByteArray::assignBuffer(void *ptr, unsigned int length)
 {
-    delete [] data_var;
-    data_var = (char *)ptr;
-    data_arraysize = length;
+    clean();
+    if (length)
+    {
+        Slice slice = { createChunk((char *)ptr, length), 0, length };
+        slices.push_back(slice);
+        dataLength = length;
+    }
+    else
+        delete [] (char *)ptr;
 }
 
 void ByteArray::truncateData(unsigned int truncleft, unsigned int truncright)
 {
-    ASSERT(data_arraysize >= (truncleft + truncright));
+    ASSERT(dataLength >= (truncleft + truncright));
+
+    dataLength -= truncleft + truncright;
 
-    if ((truncleft || truncright))
+    // drop slices from the beginning
+    SliceVector::iterator i = slices.begin();
+    while (truncleft > 0 && i->length <= truncleft)
     {
-        unsigned int nlength = data_arraysize - (truncleft + truncright);
-        char *ndata_var = NULL;
-        if (nlength)
-        {
-            ndata_var = new char[nlength];
-            memcpy(ndata_var, data_var+truncleft, nlength);
-        }
-        delete [] data_var;
-        data_var = ndata_var;
-        data_arraysize = nlength;
+        truncleft -= i->length;
+        releaseChunk(i->chunk);
+        ++i;
+    }
+    if (truncleft > 0)
+    {
+        i->offset += truncleft;
+        i->length -= truncleft;
+    }
+    slices.erase(slices.begin(), i);
+
+    // drop slices from the end
+    while (truncright > 0 && slices.back().length <= truncright)
+    {
+        truncright -= slices.back().length;
+        releaseChunk(slices.back().chunk);
+        slices.pop_back();
     }
+    if (truncright > 0)
+        slices.back().length -= truncright;
 }
@@ -16,34 +16,107 @@
 #ifndef __INET_BYTEARRAY_H
 #define __INET_BYTEARRAY_H
 
+#include <vector>
+
 #include "ByteArray_m.h"
 
 /**
  * Class that carries raw bytes.
+ *
+ * The content is a rope: a sequence of slices, each referring to a part of
+ * a reference-counted chunk. Chunks are never modified while shared, so
+ * copying, slicing (truncateData(), setDataFromByteArray()) and appending
+ * another ByteArray only adjust slices and reference counts, and do not
+ * copy the bytes themselves. setData() copies the affected slice into a
+ * private chunk first when its chunk is shared (copy-on-write).
  */
 class ByteArray : public ByteArray_Base
 {
+  protected:
+    /** Reference-counted storage block */
+    struct Chunk
+    {
+        unsigned int refCount;
+        unsigned int length;
+        char *bytes;
+    };
+
+    /** A contiguous part of a chunk */
+    struct Slice
+    {
+        Chunk *chunk;
+        unsigned int offset;
+        unsigned int length;
+    };
+
+    typedef std::vector<Slice> SliceVector;
+
+    SliceVector slices;
+    unsigned int dataLength;
+
+  private:
+    void copy(const ByteArray& other);
+    void clean();
+
+  protected:
+    /** Creates a chunk that takes ownership of a buffer allocated with new char[] */
+    static Chunk *createChunk(char *bytes, unsigned int length);
+
+    /** Releases a reference to a chunk, deletes it when it was the last one */
+    static void releaseChunk(Chunk *chunk);
+
+    /** Appends length bytes of the given slice list starting at srcOffs, sharing chunks */
+    void appendSlices(const SliceVector& src, unsigned int srcOffs, unsigned int length);
+
   public:
     /**
      * Constructor
      */
-    ByteArray() : ByteArray_Base() {}
+    ByteArray() : ByteArray_Base(), dataLength(0) {}
 
     /**
      * Copy constructor
      */
-    ByteArray(const ByteArray& other) : ByteArray_Base(other) { }
+    ByteArray(const ByteArray& other) : ByteArray_Base(other), dataLength(0) { copy(other); }
+
+    /**
+     * Destructor
+     */
+    virtual ~ByteArray() { clean(); }
 
     /**
      * operator =
      */
-    ByteArray& operator=(const ByteArray& other) {ByteArray_Base::operator=(other); return *this;}
+    ByteArray& operator=(const ByteArray& other);
 
     /**
      * Creates and returns an exact copy of this object.
      */
     virtual ByteArray *dup() const {return new ByteArray(*this);}
 
+    virtual void parsimPack(cCommBuffer *b);
+    virtual void parsimUnpack(cCommBuffer *b);
+
+    /**
+     * Resize the content, new bytes are zeroed.
+     */
+    virtual void setDataArraySize(unsigned int size);
+
+    /**
+     * Returns the length of the content
+     */
+    virtual unsigned int getDataArraySize() const { return dataLength; }
+
+    /**
+     * Returns the kth byte of content
+     */
+    virtual char getData(unsigned int k) const;
+
+    /**
+     * Set the kth byte of content
+     */
+    virtual void setData(unsigned int k, char data);
+
     /**
      * Copy data from buffer
      * @param ptr: pointer to buffer
@@ -52,7 +125,7 @@ class ByteArray : public ByteArray_Base
     virtual void setDataFromBuffer(const void *ptr, unsigned int length);
 
     /**
-     * Copy data from other ByteArray
+     * Copy data from other ByteArray. The bytes are shared, not copied.
      * @param other: reference to other ByteArray
      * @param offset: skipped first bytes from other
      * @param length: length of data
@@ -66,6 +139,15 @@ class ByteArray : public ByteArray_Base
      */
     virtual void addDataFromBuffer(const void *ptr, unsigned int length);
 
+    /**
+     * Add data from other ByteArray to the end of existing content.
+     * The bytes are shared, not copied.
+     * @param other: reference to other ByteArray
+     * @param offset: skipped first bytes from other
+     * @param length: length of data
+     */
+    virtual void addDataFromByteArray(const ByteArray& other, unsigned int offset, unsigned int length);
+
     /**
      * Copy data content to buffer
      * @param ptr: pointer to output buffer
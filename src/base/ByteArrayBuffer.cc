@@ -15,10 +15,7 @@
 #include "ByteArrayBuffer.h"
 
 ByteArrayBuffer::ByteArrayBuffer()
- :
-    dataLengthM(0)
 {
-    // FIXME
 }
 
 ByteArrayBuffer::ByteArrayBuffer(const ByteArrayBuffer& other)
@@ -37,38 +34,33 @@ ByteArrayBuffer& ByteArrayBuffer::operator=(const ByteArrayBuffer& other)
 
 void ByteArrayBuffer::push(const ByteArray& byteArrayP)
 {
-    dataListM.push_back(byteArrayP);
-    dataLengthM += byteArrayP.getDataArraySize();
+    dataM.addDataFromByteArray(byteArrayP, 0, byteArrayP.getDataArraySize());
 }
 
 void ByteArrayBuffer::push(const void* bufferP, unsigned int bufferLengthP)
 {
-    ByteArray byteArray;
-    dataListM.push_back(byteArray);
-    dataListM.back().setDataFromBuffer(bufferP, bufferLengthP);
-    dataLengthM += bufferLengthP;
+    dataM.addDataFromBuffer(bufferP, bufferLengthP);
 }
 
 unsigned int ByteArrayBuffer::getBytesToBuffer(void* bufferP, unsigned int bufferLengthP, unsigned int srcOffsP) const
 {
-    unsigned int copiedBytes = 0;
-    DataList::const_iterator i;
+    return dataM.copyDataToBuffer(bufferP, bufferLengthP, srcOffsP);
+}
+
+unsigned int ByteArrayBuffer::getBytesToByteArray(ByteArray& byteArrayP, unsigned int lengthP, unsigned int srcOffsP) const
+{
+    unsigned int dataLength = dataM.getDataArraySize();
 
-    for (i = this->dataListM.begin(); (copiedBytes < bufferLengthP) && (i != dataListM.end()); ++i)
-    {
-        unsigned int cbytes = i->copyDataToBuffer((char *)bufferP + copiedBytes,
-                bufferLengthP - copiedBytes, srcOffsP);
-        if (cbytes)
-        {
-            copiedBytes += cbytes;
-            srcOffsP = 0;
-        }
-        else
-        {
-            srcOffsP -= i->getDataArraySize();
-        }
-    }
-    return copiedBytes;
+    if (srcOffsP >= dataLength)
+        lengthP = 0;
+    else if (srcOffsP + lengthP > dataLength)
+        lengthP = dataLength - srcOffsP;
+
+    if (lengthP)
+        byteArrayP.setDataFromByteArray(dataM, srcOffsP, lengthP);
+    else
+        byteArrayP.setDataArraySize(0);
+    return lengthP;
 }
 
 unsigned int ByteArrayBuffer::popBytesToBuffer(void* bufferP, unsigned int bufferLengthP)
@@ -78,38 +70,13 @@ unsigned int ByteArrayBuffer::popBytesToBuffer(void* bufferP, unsigned int buffe
 
 unsigned int ByteArrayBuffer::drop(unsigned int lengthP)
 {
-    ASSERT(lengthP <= dataLengthM);
+    ASSERT(lengthP <= dataM.getDataArraySize());
 
-    unsigned int length = lengthP;
-
-    while (length > 0)
-    {
-        unsigned int sliceLength = dataListM.front().getDataArraySize();
-
-        if (sliceLength <= length)
-        {
-            dataListM.pop_front();
-            dataLengthM -= sliceLength;
-            length -= sliceLength;
-        }
-        else
-        {
-            dataListM.front().truncateData(length);
-            dataLengthM -= length;
-            length = 0;
-        }
-    }
-    ASSERT(0 == length);
+    dataM.truncateData(lengthP);
     return lengthP;
 }
 
 void ByteArrayBuffer::clear()
 {
-    dataLengthM = 0;
-
-    while (dataListM.begin() != dataListM.end())
-    {
-        dataListM.pop_front();
-    }
+    dataM.setDataArraySize(0);
 }
-
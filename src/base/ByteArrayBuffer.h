@@ -19,16 +19,18 @@
 
 /**
  * Buffer that carries BytesArrays.
+ *
+ * Pushed ByteArrays are appended to a single ByteArray rope, so push(),
+ * drop() and getBytesToByteArray() share the underlying chunks instead of
+ * copying bytes.
  */
 class ByteArrayBuffer : public cObject
 {
   protected:
-    typedef std::list<ByteArray> DataList;
-    uint64 dataLengthM;
-    DataList dataListM;
+    ByteArray dataM;
 
   private:
-    void copy(const ByteArrayBuffer& other) { dataLengthM = other.dataLengthM; dataListM = other.dataListM; }
+    void copy(const ByteArrayBuffer& other) { dataM = other.dataM; }
 
   public:
     /** Ctor. */
@@ -50,7 +52,7 @@ class ByteArrayBuffer : public cObject
     virtual void push(const void* bufferP, unsigned int bufferLengthP);
 
     /** Returns length of stored data */
-    virtual uint64 getLength() const { return dataLengthM; }
+    virtual uint64 getLength() const { return dataM.getDataArraySize(); }
 
     /**
      * Copy bytes to an external buffer
@@ -61,6 +63,15 @@ class ByteArrayBuffer : public cObject
      */
     virtual unsigned int getBytesToBuffer(void* bufferP, unsigned int bufferLengthP, unsigned int srcOffsP = 0) const;
 
+    /**
+     * Copy bytes to a ByteArray, sharing the stored data
+     * @param byteArrayP: output ByteArray, its previous content is replaced
+     * @param lengthP: maximum count of bytes
+     * @param srcOffsP: source offset
+     * @return count of bytes in byteArrayP
+     */
+    virtual unsigned int getBytesToByteArray(ByteArray& byteArrayP, unsigned int lengthP, unsigned int srcOffsP = 0) const;
+
     /**
      * Move bytes to an external buffer
      * @param bufferP: pointer to output buffer
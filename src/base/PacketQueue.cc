@@ -0,0 +1,62 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "PacketQueue.h"
+
+
+PacketQueue::PacketQueue(const char *name, int frameCapacity, int64 byteCapacity) :
+        byteLength(0), frameCapacity(frameCapacity), byteCapacity(byteCapacity)
+{
+    setName(name);
+}
+
+void PacketQueue::setName(const char *name)
+{
+    dataQueue.setName(name);
+    controlQueue.setName(name ? (std::string(name) + ".control").c_str() : NULL);
+}
+
+void PacketQueue::setCapacity(int frameCapacity, int64 byteCapacity)
+{
+    this->frameCapacity = frameCapacity;
+    this->byteCapacity = byteCapacity;
+}
+
+void PacketQueue::insert(cPacket *pk, bool isControl)
+{
+    byteLength += pk->getByteLength();
+    if (isControl)
+        controlQueue.insert(pk);
+    else
+        dataQueue.insert(pk);
+}
+
+cPacket *PacketQueue::pop()
+{
+    cQueue& queue = controlQueue.empty() ? dataQueue : controlQueue;
+    if (queue.empty())
+        return NULL;
+
+    cPacket *pk = static_cast<cPacket *>(queue.pop());
+    byteLength -= pk->getByteLength();
+    return pk;
+}
+
+cPacket *PacketQueue::front() const
+{
+    const cQueue& queue = controlQueue.empty() ? dataQueue : controlQueue;
+    return queue.empty() ? NULL : static_cast<cPacket *>(queue.front());
+}
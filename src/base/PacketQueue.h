@@ -0,0 +1,84 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __INET_PACKETQUEUE_H
+#define __INET_PACKETQUEUE_H
+
+#include "INETDefs.h"
+
+
+/**
+ * Packet queue with two lanes: a control lane (e.g. Ethernet PAUSE frames)
+ * that is always served first, and a FIFO data lane. Both lanes are cQueues
+ * without a compare function, so insertion and removal are O(1); the caller
+ * tells which lane a packet goes to, so no type checks are done here.
+ *
+ * The queue can be limited in frames and in bytes (0 means unlimited); it is
+ * up to the owner what to do with a packet that would exceed the limits,
+ * see wouldOverflow().
+ *
+ * The data lane gets the queue's name, so it can be referred to from the
+ * "q" tag of display strings.
+ */
+class INET_API PacketQueue
+{
+  protected:
+    cQueue controlQueue;
+    cQueue dataQueue;
+    int64 byteLength;       // total length of the queued packets
+    int frameCapacity;      // 0 means unlimited
+    int64 byteCapacity;     // 0 means unlimited
+
+  public:
+    PacketQueue(const char *name = NULL, int frameCapacity = 0, int64 byteCapacity = 0);
+
+    void setName(const char *name);
+    void setCapacity(int frameCapacity, int64 byteCapacity = 0);
+    int getFrameCapacity() const {return frameCapacity;}
+    int64 getByteCapacity() const {return byteCapacity;}
+
+    /**
+     * Returns true if inserting the packet would exceed the frame
+     * or byte capacity.
+     */
+    bool wouldOverflow(const cPacket *pk) const {
+        return (frameCapacity && length() >= frameCapacity) ||
+               (byteCapacity && byteLength + pk->getByteLength() > byteCapacity);
+    }
+
+    /**
+     * Appends the packet to the data lane, or to the control lane if
+     * isControl is true. The queue takes ownership of the packet.
+     */
+    void insert(cPacket *pk, bool isControl = false);
+
+    /**
+     * Removes and returns the first packet of the control lane, or of the
+     * data lane if the control lane is empty. Returns NULL if the queue is empty.
+     */
+    cPacket *pop();
+
+    /**
+     * Returns the packet pop() would return, without removing it.
+     */
+    cPacket *front() const;
+
+    bool empty() const {return controlQueue.empty() && dataQueue.empty();}
+    int length() const {return controlQueue.length() + dataQueue.length();}
+    int64 getByteLength() const {return byteLength;}
+};
+
+#endif
@@ -19,9 +19,9 @@
 #include <string.h>
 #include <stdarg.h>
 #include <deque>
-#include <list>
 #include <algorithm>
 #include <sstream>
+#include <map>
 #include "Topology.h"
 #include "PatternMatcher.h"
 #include "stlutils.h"
@@ -30,6 +30,86 @@
 Register_Class(Topology);
 
 
+struct Topology::Snapshot
+{
+    struct LinkRecord
+    {
+        int srcGateId;
+        int destIndex;   // index into moduleIds
+        int destGateId;
+    };
+
+    std::vector<int> moduleIds;      // selected modules in ascending ID order
+    std::vector<int> firstLink;      // out links of node k are links[firstLink[k]..firstLink[k+1]-1]
+    std::vector<LinkRecord> links;
+    std::vector<int> numInLinks;
+};
+
+/**
+ * Simulation-wide cache of extractByProperty() scans, keyed by property name
+ * and value. It listens to POST_MODEL_CHANGE on the system module, and drops
+ * all snapshots when the module graph changes or the network is deleted.
+ */
+class TopologySnapshotCache : public cListener
+{
+  protected:
+    typedef std::map<std::string, Topology::Snapshot> SnapshotMap;
+    SnapshotMap snapshots;
+    cModule *systemModule;   // where we are subscribed, or NULL
+
+  public:
+    TopologySnapshotCache() { systemModule = NULL; }
+
+    static TopologySnapshotCache *getInstance()
+    {
+        // never deleted: the instance must outlive the network it listens to
+        static TopologySnapshotCache *instance = new TopologySnapshotCache();
+        return instance;
+    }
+
+    Topology::Snapshot *lookup(const std::string& key)
+    {
+        if (systemModule != simulation.getSystemModule())
+            return NULL;
+        SnapshotMap::iterator it = snapshots.find(key);
+        return it == snapshots.end() ? NULL : &it->second;
+    }
+
+    Topology::Snapshot *insert(const std::string& key)
+    {
+        cModule *currentSystemModule = simulation.getSystemModule();
+        if (systemModule != currentSystemModule)
+        {
+            if (systemModule)
+                systemModule->unsubscribe(POST_MODEL_CHANGE, this);
+            snapshots.clear();
+            systemModule = currentSystemModule;
+            systemModule->subscribe(POST_MODEL_CHANGE, this);
+        }
+        return &snapshots[key];
+    }
+
+    virtual void receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj)
+    {
+        if (dynamic_cast<cPostModuleAddNotification *>(obj) || dynamic_cast<cPostModuleDeleteNotification *>(obj) ||
+            dynamic_cast<cPostModuleReparentNotification *>(obj) || dynamic_cast<cPostGateAddNotification *>(obj) ||
+            dynamic_cast<cPostGateDeleteNotification *>(obj) || dynamic_cast<cPostGateVectorResizeNotification *>(obj) ||
+            dynamic_cast<cPostGateConnectNotification *>(obj) || dynamic_cast<cPostGateDisconnectNotification *>(obj))
+            snapshots.clear();
+    }
+
+    virtual void unsubscribedFrom(cComponent *component, simsignal_t signalID)
+    {
+        // the network is being deleted
+        if (component == systemModule)
+        {
+            snapshots.clear();
+            systemModule = NULL;
+        }
+    }
+};
+
+
 Topology::LinkIn *Topology::Node::getLinkIn(int i)
 {
     if (i<0 || i>=(int)inLinks.size())
@@ -49,6 +129,7 @@ Topology::LinkOut *Topology::Node::getLinkOut(int i)
 Topology::Topology(const char *name) : cOwnedObject(name)
 {
     target = NULL;
+    heapSeqCounter = 0;
 }
 
 Topology::Topology(const Topology& topo) : cOwnedObject(topo)
@@ -150,8 +231,16 @@ void Topology::extractByNedTypeName(const std::vector<std::string>& nedTypeNames
 
 void Topology::extractByProperty(const char *propertyName, const char *value)
 {
-    struct {const char *name; const char *value;} data = {propertyName, value};
-    extractFromNetwork(selectByProperty, (void *)&data);
+    std::string key = value ? std::string(propertyName) + "=" + value : std::string(propertyName);
+    TopologySnapshotCache *cache = TopologySnapshotCache::getInstance();
+    Snapshot *snapshot = cache->lookup(key);
+    if (!snapshot)
+    {
+        struct {const char *name; const char *value;} data = {propertyName, value};
+        snapshot = cache->insert(key);
+        scanNetwork(selectByProperty, (void *)&data, *snapshot);
+    }
+    extractFromSnapshot(*snapshot);
 }
 
 void Topology::extractByParameter(const char *paramName, const char *paramValue)
@@ -175,26 +264,34 @@ void Topology::extractFromNetwork(Predicate *predicate)
 
 void Topology::extractFromNetwork(bool (*predicate)(cModule *,void *), void *data)
 {
-    clear();
+    Snapshot snapshot;
+    scanNetwork(predicate, data, snapshot);
+    extractFromSnapshot(snapshot);
+}
+
+void Topology::scanNetwork(bool (*predicate)(cModule *,void *), void *data, Snapshot& snapshot)
+{
+    snapshot.moduleIds.clear();
+    snapshot.firstLink.clear();
+    snapshot.links.clear();
 
     // Loop through all modules and find those that satisfy the criteria
     for (int modId=0; modId<=simulation.getLastModuleId(); modId++)
     {
         cModule *module = simulation.getModule(modId);
-        if (module && predicate(module, data)) {
-            Node *node = createNode(module);
-            nodes.push_back(node);
-        }
+        if (module && predicate(module, data))
+            snapshot.moduleIds.push_back(modId);
     }
+    snapshot.numInLinks.assign(snapshot.moduleIds.size(), 0);
 
     // Discover out neighbors too.
-    for (int k=0; k<(int)nodes.size(); k++)
+    for (int k=0; k<(int)snapshot.moduleIds.size(); k++)
     {
         // Loop through all its gates and find those which come
         // from or go to modules included in the topology.
 
-        Node *node = nodes[k];
-        cModule *mod = simulation.getModule(node->moduleId);
+        snapshot.firstLink.push_back(snapshot.links.size());
+        cModule *mod = simulation.getModule(snapshot.moduleIds[k]);
 
         for (cModule::GateIterator i(mod); !i.end(); i++)
         {
@@ -212,22 +309,44 @@ void Topology::extractFromNetwork(bool (*predicate)(cModule *,void *), void *dat
             // if we arrived at a module in the topology, record it.
             if (gate)
             {
-                Link *link = createLink();
-                link->srcNode = node;
-                link->srcGateId = srcGate->getId();
-                link->destNode = getNodeFor(gate->getOwnerModule());
-                link->destGateId = gate->getId();
-                node->outLinks.push_back(link);
+                Snapshot::LinkRecord link;
+                link.srcGateId = srcGate->getId();
+                link.destIndex = std::lower_bound(snapshot.moduleIds.begin(), snapshot.moduleIds.end(), gate->getOwnerModule()->getId()) - snapshot.moduleIds.begin();
+                link.destGateId = gate->getId();
+                snapshot.links.push_back(link);
+                snapshot.numInLinks[link.destIndex]++;
             }
         }
     }
+    snapshot.firstLink.push_back(snapshot.links.size());
+}
 
-    // fill inLinks vectors
-    for (int k=0; k<(int)nodes.size(); k++)
+void Topology::extractFromSnapshot(const Snapshot& snapshot)
+{
+    clear();
+
+    int numNodes = snapshot.moduleIds.size();
+    nodes.reserve(numNodes);
+    for (int k=0; k<numNodes; k++)
+    {
+        Node *node = createNode(simulation.getModule(snapshot.moduleIds[k]));
+        node->outLinks.reserve(snapshot.firstLink[k+1] - snapshot.firstLink[k]);
+        node->inLinks.reserve(snapshot.numInLinks[k]);
+        nodes.push_back(node);
+    }
+
+    // create links; inLinks are filled in the order of the source nodes
+    for (int k=0; k<numNodes; k++)
     {
-        for (int l=0; l<(int)nodes[k]->outLinks.size(); l++)
+        for (int l=snapshot.firstLink[k]; l<snapshot.firstLink[k+1]; l++)
         {
-            Topology::Link *link = nodes[k]->outLinks[l];
+            const Snapshot::LinkRecord& record = snapshot.links[l];
+            Link *link = createLink();
+            link->srcNode = nodes[k];
+            link->srcGateId = record.srcGateId;
+            link->destNode = nodes[record.destIndex];
+            link->destGateId = record.destGateId;
+            nodes[k]->outLinks.push_back(link);
             link->destNode->inLinks.push_back(link);
         }
     }
@@ -402,6 +521,70 @@ void Topology::calculateUnweightedSingleShortestPathsTo(Node *_target)
     }
 }
 
+void Topology::heapSiftUp(int i)
+{
+    Node *node = heap[i];
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        if (!isHeapLess(node, heap[parent]))
+            break;
+        heap[i] = heap[parent];
+        heap[i]->heapIndex = i;
+        i = parent;
+    }
+    heap[i] = node;
+    node->heapIndex = i;
+}
+
+void Topology::heapSiftDown(int i)
+{
+    int size = heap.size();
+    Node *node = heap[i];
+    while (true)
+    {
+        int child = 2 * i + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && isHeapLess(heap[child + 1], heap[child]))
+            child++;
+        if (!isHeapLess(heap[child], node))
+            break;
+        heap[i] = heap[child];
+        heap[i]->heapIndex = i;
+        i = child;
+    }
+    heap[i] = node;
+    node->heapIndex = i;
+}
+
+void Topology::heapPushOrDecrease(Node *node)
+{
+    // the node's dist has just been decreased (or set); a new sequence
+    // number puts it behind the queued nodes of equal distance
+    node->heapSeq = heapSeqCounter++;
+    if (node->heapIndex < 0)
+    {
+        heap.push_back(node);
+        node->heapIndex = heap.size() - 1;
+    }
+    heapSiftUp(node->heapIndex);
+}
+
+Topology::Node *Topology::heapPop()
+{
+    Node *top = heap.front();
+    top->heapIndex = -1;
+    Node *last = heap.back();
+    heap.pop_back();
+    if (!heap.empty())
+    {
+        heap[0] = last;
+        heapSiftDown(0);
+    }
+    return top;
+}
+
 void Topology::calculateWeightedSingleShortestPathsTo(Node *_target)
 {
     if (!_target)
@@ -413,52 +596,45 @@ void Topology::calculateWeightedSingleShortestPathsTo(Node *_target)
     {
        nodes[i]->dist = INFINITY;
        nodes[i]->outPath = NULL;
+       nodes[i]->heapIndex = -1;
     }
 
     target->dist = 0;
 
-    std::list<Node*> q;
+    heap.clear();
+    heap.reserve(nodes.size());
+    heapSeqCounter = 0;
+    heapPushOrDecrease(target);
 
-    q.push_back(target);
-
-    while (!q.empty())
+    while (!heap.empty())
     {
-        Node *dest = q.front();
-        q.pop_front();
+        Node *dest = heapPop();
 
         ASSERT(dest->getWeight() >= 0.0);
 
         // for each w adjacent to v...
-        for (int i=0; i < dest->getNumInLinks(); i++)
+        for (int i=0; i < (int)dest->inLinks.size(); i++)
         {
-            if (!(dest->getLinkIn(i)->isEnabled()))
+            Link *link = dest->inLinks[i];
+            if (!link->enabled)
                 continue;
 
-            Node *src = dest->getLinkIn(i)->getRemoteNode();
-            if (!src->isEnabled())
+            Node *src = link->srcNode;
+            if (!src->enabled)
                 continue;
 
-            double linkWeight = dest->getLinkIn(i)->getWeight();
+            double linkWeight = link->weight;
             ASSERT(linkWeight > 0.0);
 
             double newdist = dest->dist + linkWeight;
             if (dest != target)
-                newdist += dest->getWeight();  // dest is not the target, uses weight of dest node as price of routing (infinity means dest node doesn't route between interfaces)
+                newdist += dest->weight;  // dest is not the target, uses weight of dest node as price of routing (infinity means dest node doesn't route between interfaces)
             if (newdist != INFINITY && src->dist > newdist)  // it's a valid shorter path from src to target node
             {
-                if (src->dist != INFINITY)
-                    q.remove(src);   // src is in the queue
                 src->dist = newdist;
-                src->outPath = dest->inLinks[i];
-
-                // insert src node to ordered list
-                std::list<Node*>::iterator it;
-                for (it = q.begin(); it != q.end(); ++it)
-                    if ((*it)->dist > newdist)
-                        break;
-                q.insert(it, src);
+                src->outPath = link;
+                heapPushOrDecrease(src);
             }
         }
     }
 }
-
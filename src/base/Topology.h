@@ -79,12 +79,14 @@ class INET_API Topology : public cOwnedObject
         // variables used by the shortest-path algorithms
         double dist;
         Link *outPath;
+        int heapIndex;          // position in the Dijkstra heap, -1 if not in the heap
+        unsigned int heapSeq;   // insertion order, breaks ties between equal distances
 
       public:
         /**
          * Constructor
          */
-        Node(int moduleId=-1) {this->moduleId=moduleId; weight=0; enabled=true; dist=INFINITY; outPath=NULL;}
+        Node(int moduleId=-1) {this->moduleId=moduleId; weight=0; enabled=true; dist=INFINITY; outPath=NULL; heapIndex=-1; heapSeq=0;}
         virtual ~Node() {}
 
         /** @name Node attributes: weight, enabled state, correspondence to modules. */
@@ -330,10 +332,20 @@ class INET_API Topology : public cOwnedObject
         virtual bool matches(cModule *module) = 0;
     };
 
+    /**
+     * The result of scanning the network for the modules and connections of
+     * a topology, stored in flat arrays. Defined in Topology.cc.
+     */
+    struct Snapshot;
+
   protected:
     std::vector<Node*> nodes;
     Node *target;
 
+    // binary heap of the Dijkstra algorithm, ordered by (dist, heapSeq)
+    std::vector<Node*> heap;
+    unsigned int heapSeqCounter;
+
     // note: the purpose of the (unsigned int) cast is that nodes with moduleId==-1 are inserted at the end of the vector
     static bool lessByModuleId(Node *a, Node *b) { return (unsigned int)a->moduleId < (unsigned int)b->moduleId; }
     static bool isModuleIdLess(Node *a, int moduleId) { return (unsigned int)a->moduleId < (unsigned int)moduleId; }
@@ -341,6 +353,15 @@ class INET_API Topology : public cOwnedObject
     void unlinkFromSourceNode(Link *link);
     void unlinkFromDestNode(Link *link);
 
+    static void scanNetwork(bool (*selfunc)(cModule *,void *), void *userdata, Snapshot& snapshot);
+    void extractFromSnapshot(const Snapshot& snapshot);
+
+    static bool isHeapLess(Node *a, Node *b) { return a->dist < b->dist || (a->dist == b->dist && a->heapSeq < b->heapSeq); }
+    void heapPushOrDecrease(Node *node);
+    Node *heapPop();
+    void heapSiftUp(int i);
+    void heapSiftDown(int i);
+
   public:
     /** @name Constructors, destructor, assignment */
     //@{
@@ -458,6 +479,11 @@ class INET_API Topology : public cOwnedObject
      * }
      * </pre>
      *
+     * The result of the network scan is cached simulation-wide, so that
+     * network configurators and other modules extracting the same topology
+     * walk the module tree only once. The cache is dropped when modules,
+     * gates or connections are created or deleted (POST_MODEL_CHANGE), and
+     * when the network is deleted.
      */
     void extractByProperty(const char *propertyName, const char *value=NULL);
 
@@ -557,6 +583,11 @@ class INET_API Topology : public cOwnedObject
      * Apply the Dijkstra algorithm to find all shortest paths to the given
      * graph node. The paths found can be extracted via Node's methods.
      * Uses weights in nodes and links.
+     *
+     * The priority queue is a binary heap with decrease-key, so one call
+     * costs O(E log V). Nodes of equal distance are expanded in the order
+     * they were (last) queued, which yields the same paths as the former
+     * sorted-list implementation.
      */
     void calculateWeightedSingleShortestPathsTo(Node *target);
 
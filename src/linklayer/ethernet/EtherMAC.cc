@@ -260,15 +260,15 @@ void EtherMAC::processFrameFromUpperLayer(EtherFrame *frame)
     }
     else
     {
-        if (txQueue.innerQueue->isFull())
+        if (txQueue.innerQueue->wouldOverflow(frame))
             error("txQueue length exceeds %d -- this is probably due to "
                   "a bogus app model generating excessive traffic "
                   "(or if this is normal, increase txQueueLimit!)",
-                  txQueue.innerQueue->getQueueLimit());
+                  txQueue.innerQueue->getFrameCapacity());
 
         // store frame and possibly begin transmitting
         EV << "Frame " << frame << " arrived from higher layer, enqueueing\n";
-        txQueue.innerQueue->insertFrame(frame);
+        txQueue.innerQueue->insert(frame, isPauseFrame);
 
         if (!curTxFrame && !txQueue.innerQueue->empty())
             curTxFrame = (EtherFrame*)txQueue.innerQueue->pop();
@@ -665,12 +665,3 @@ void EtherMACBase::updateConnectionColor(int txState)
         }
     }
 }
-
-
-int EtherMACBase::InnerQueue::packetCompare(cObject *a, cObject *b)
-{
-    int ap = (dynamic_cast<EtherPauseFrame*>(a) == NULL) ? 1 : 0;
-    int bp = (dynamic_cast<EtherPauseFrame*>(b) == NULL) ? 1 : 0;
-    return ap - bp;
-}
-
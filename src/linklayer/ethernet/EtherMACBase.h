@@ -24,6 +24,7 @@
 
 #include "IPassiveQueue.h"
 #include "MACAddress.h"
+#include "PacketQueue.h"
 
 // Forward declarations:
 class EtherFrame;
@@ -85,29 +86,10 @@ class INET_API EtherMACBase : public cSimpleModule, public cListener
         double        maxPropagationDelay;  // used for detecting longer cables than allowed
     };
 
-    class InnerQueue
-    {
-      protected:
-        cQueue queue;
-        int queueLimit;               // max queue length
-
-      protected:
-        static int packetCompare(cObject *a, cObject *b);  // PAUSE frames have higher priority
-
-      public:
-        InnerQueue(const char* name = NULL, int limit = 0) : queue(name, packetCompare), queueLimit(limit) {}
-        void insertFrame(cObject *obj) { queue.insert(obj); }
-        cObject *pop() { return queue.pop(); }
-        bool empty() const { return queue.empty(); }
-        int getQueueLimit() const { return queueLimit; }
-        bool isFull() const { return queueLimit != 0 && queue.length() > queueLimit; }
-        int length() const { return queue.length(); }
-    };
-
     class MacQueue
     {
       public:
-        InnerQueue *innerQueue;
+        PacketQueue *innerQueue;
         IPassiveQueue *extQueue;
 
       public:
@@ -117,7 +99,7 @@ class INET_API EtherMACBase : public cSimpleModule, public cListener
         void setExternalQueue(IPassiveQueue *_extQueue)
                 { delete innerQueue; innerQueue = NULL; extQueue = _extQueue; };
         void setInternalQueue(const char* name = NULL, int limit = 0)
-                { delete innerQueue; innerQueue = new InnerQueue(name, limit); extQueue = NULL; };
+                { delete innerQueue; innerQueue = new PacketQueue(name, limit); extQueue = NULL; };
     };
 
     // MAC constants for bitrates and modes
@@ -38,6 +38,8 @@ void EtherMACFullDuplex::initialize()
     if (!par("duplexMode").boolValue())
         throw cRuntimeError("Half duplex operation is not supported by EtherMACFullDuplex, use the EtherMAC module for that! (Please enable csmacdSupport on EthernetInterface)");
 
+    eventCoalescing = par("eventCoalescing").boolValue();
+
     beginSendFrames();
 }
 
@@ -90,6 +92,11 @@ void EtherMACFullDuplex::handleSelfMessage(cMessage *msg)
 }
 
 void EtherMACFullDuplex::startFrameTransmission()
+{
+    startFrameTransmission(simTime());
+}
+
+void EtherMACFullDuplex::startFrameTransmission(simtime_t startTime)
 {
     ASSERT(curTxFrame);
     EV << "Transmitting a copy of frame " << curTxFrame << endl;
@@ -105,9 +112,13 @@ void EtherMACFullDuplex::startFrameTransmission()
     // add preamble and SFD (Starting Frame Delimiter), then send out
     frame->addByteLength(PREAMBLE_BYTES+SFD_BYTES);
 
-    // send
+    // send; if the transmission starts later (eventCoalescing), the channel
+    // will be busy from startTime on
     EV << "Starting transmission of " << frame << endl;
-    send(frame, physOutGate);
+    if (startTime > simTime())
+        sendDelayed(frame, startTime - simTime(), physOutGate);
+    else
+        send(frame, physOutGate);
 
     scheduleAt(transmissionChannel->getTransmissionFinishTime(), endTxMsg);
     transmitState = TRANSMITTING_STATE;
@@ -166,14 +177,14 @@ void EtherMACFullDuplex::processFrameFromUpperLayer(EtherFrame *frame)
     }
     else
     {
-        if (txQueue.innerQueue->isFull())
+        if (txQueue.innerQueue->wouldOverflow(frame))
             error("txQueue length exceeds %d -- this is probably due to "
                   "a bogus app model generating excessive traffic "
                   "(or if this is normal, increase txQueueLimit!)",
-                  txQueue.innerQueue->getQueueLimit());
+                  txQueue.innerQueue->getFrameCapacity());
         // store frame and possibly begin transmitting
         EV << "Frame " << frame << " arrived from higher layers, enqueueing\n";
-        txQueue.innerQueue->insertFrame(frame);
+        txQueue.innerQueue->insert(frame, isPauseFrame);
 
         if (!curTxFrame && !txQueue.innerQueue->empty())
             curTxFrame = (EtherFrame*)txQueue.innerQueue->pop();
@@ -181,6 +192,14 @@ void EtherMACFullDuplex::processFrameFromUpperLayer(EtherFrame *frame)
 
     if (transmitState == TX_IDLE_STATE)
         startFrameTransmission();
+    else if (eventCoalescing && transmitState == WAIT_IFG_STATE && curTxFrame)
+    {
+        // the frame would go out at the end of the IFG anyway: send it now
+        // with a delay, and spare the EndIFG event
+        simtime_t endIFGTime = endIFGMsg->getArrivalTime();
+        cancelEvent(endIFGMsg);
+        startFrameTransmission(endIFGTime);
+    }
 }
 
 void EtherMACFullDuplex::processMsgFromNetwork(EtherTraffic *msg)
@@ -359,8 +378,17 @@ void EtherMACFullDuplex::processPauseCommand(int pauseUnits)
 void EtherMACFullDuplex::scheduleEndIFGPeriod()
 {
     EtherIFG gap;
+    simtime_t endIFGTime = simTime() + transmissionChannel->calculateDuration(&gap);
+
+    if (eventCoalescing && curTxFrame)
+    {
+        // back-to-back transmission: the next frame starts when the IFG is over
+        startFrameTransmission(endIFGTime);
+        return;
+    }
+
     transmitState = WAIT_IFG_STATE;
-    scheduleAt(simTime() + transmissionChannel->calculateDuration(&gap), endIFGMsg);
+    scheduleAt(endIFGTime, endIFGMsg);
 }
 
 void EtherMACFullDuplex::scheduleEndPausePeriod(int pauseUnits)
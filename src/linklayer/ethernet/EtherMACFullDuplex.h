@@ -50,6 +50,7 @@ class INET_API EtherMACFullDuplex : public EtherMACBase
 
     // helpers
     virtual void startFrameTransmission();
+    virtual void startFrameTransmission(simtime_t startTime);
     virtual void processFrameFromUpperLayer(EtherFrame *frame);
     virtual void processMsgFromNetwork(EtherTraffic *msg);
     virtual void processReceivedDataFrame(EtherFrame *frame);
@@ -58,6 +59,8 @@ class INET_API EtherMACFullDuplex : public EtherMACBase
     virtual void scheduleEndPausePeriod(int pauseUnits);
     virtual void beginSendFrames();
 
+    // configuration
+    bool eventCoalescing;   // send the next frame right away, delayed by the IFG, instead of scheduling an EndIFG event
 
     // statistics
     simtime_t totalSuccessfulRxTime; // total duration of successful transmissions on channel
@@ -136,10 +136,16 @@ void MACRelayUnitBase::handleAndDispatchFrame(EtherFrame *frame, int inputport)
 
 void MACRelayUnitBase::broadcastFrame(EtherFrame *frame, int inputport)
 {
-    for (int i=0; i<numPorts; ++i)
+    // the last port gets the original frame, the others get copies
+    int lastPort = (inputport == numPorts-1) ? numPorts-2 : numPorts-1;
+    for (int i=0; i<lastPort; ++i)
         if (i != inputport)
-            send((EtherFrame*)frame->dup(), "lowerLayerOut", i);
-    delete frame;
+            send(frame->dup(), "lowerLayerOut", i);
+
+    if (lastPort >= 0)
+        send(frame, "lowerLayerOut", lastPort);
+    else
+        delete frame;
 }
 
 void MACRelayUnitBase::printAddressTable()
@@ -86,6 +86,11 @@ class INET_API MACRelayUnitBase : public cSimpleModule
     /**
      * Utility function: sends the frame on all ports except inputport.
      * The message pointer should not be referenced any more after this call.
+     *
+     * The copies share the encapsulated packet with the original (cPacket
+     * reference counting), so only the Ethernet frame objects are
+     * duplicated; do not call getEncapsulatedPacket() on them here, as
+     * that would make a private copy of the payload.
      */
     virtual void broadcastFrame(EtherFrame *frame, int inputport);
 
@@ -203,5 +203,17 @@ void ExtInterface::finish()
 {
     std::cout << getFullPath() << ": " << numSent << " packets sent, " <<
             numRcvd << " packets received, " << numDropped <<" packets dropped.\n";
+
+    cSocketRTScheduler::CaptureStats stats;
+    if (connected && rtScheduler->getCaptureStats(this, stats))
+    {
+        recordScalar("captured packets", stats.numCaptured);
+        recordScalar("capture drops", stats.numDropped);
+        recordScalar("skipped non-IP frames", stats.numSkipped);
+        recordScalar("capture bursts", stats.numBursts);
+        recordScalar("max capture latency", stats.maxLatency);
+        if (stats.numCaptured > 0)
+            recordScalar("mean capture latency", stats.totalLatency / (double)stats.numCaptured);
+    }
 }
 
@@ -31,12 +31,15 @@
 
 #define PCAP_SNAPLEN 65536 /* capture all data packets with up to pcap_snaplen bytes */
 #define PCAP_TIMEOUT 10    /* Timeout in ms */
+#define PCAP_BURST 64      /* max number of packets processed per interface in one pcap_dispatch() call */
 
 #ifdef HAVE_PCAP
 std::vector<cModule *>cSocketRTScheduler::modules;
 std::vector<pcap_t *>cSocketRTScheduler::pds;
 std::vector<int32>cSocketRTScheduler::datalinks;
 std::vector<int32>cSocketRTScheduler::headerLengths;
+std::vector<int32>cSocketRTScheduler::selectableFds;
+std::vector<cSocketRTScheduler::CaptureStats>cSocketRTScheduler::captureStats;
 #endif
 timeval cSocketRTScheduler::baseTime;
 
@@ -85,7 +88,12 @@ void cSocketRTScheduler::endRun()
         if (pcap_stats(pds.at(i), &ps) < 0)
             throw cRuntimeError("cSocketRTScheduler::endRun(): Cannot query pcap statistics: %s", pcap_geterr(pds.at(i)));
         else
-            EV << modules.at(i)->getFullPath() << ": Received Packets: " << ps.ps_recv << " Dropped Packets: " << ps.ps_drop << ".\n";
+        {
+            const CaptureStats& stats = captureStats.at(i);
+            EV << modules.at(i)->getFullPath() << ": Received Packets: " << ps.ps_recv << " Dropped Packets: " << ps.ps_drop
+               << " Captured IP Packets: " << stats.numCaptured << " in " << stats.numBursts << " bursts"
+               << " Max Latency: " << stats.maxLatency << "s.\n";
+        }
         pcap_close(pds.at(i));
     }
 
@@ -94,6 +102,8 @@ void cSocketRTScheduler::endRun()
     pds.clear();
     datalinks.clear();
     headerLengths.clear();
+    selectableFds.clear();
+    captureStats.clear();
 #endif
 }
 
@@ -158,6 +168,10 @@ void cSocketRTScheduler::setInterfaceModule(cModule *mod, const char *dev, const
     pds.push_back(pd);
     datalinks.push_back(datalink);
     headerLengths.push_back(headerLength);
+#ifdef LINUX
+    selectableFds.push_back(pcap_get_selectable_fd(pd));
+#endif
+    captureStats.push_back(CaptureStats());
 
     EV << "Opened pcap device " << dev << " with filter " << filter << " and datalink " << datalink << ".\n";
 #else
@@ -165,6 +179,24 @@ void cSocketRTScheduler::setInterfaceModule(cModule *mod, const char *dev, const
 #endif
 }
 
+bool cSocketRTScheduler::getCaptureStats(cModule *mod, CaptureStats& stats)
+{
+#ifdef HAVE_PCAP
+    for (uint16 i=0; i<modules.size(); i++)
+    {
+        if (modules.at(i) != mod)
+            continue;
+
+        stats = captureStats.at(i);
+        pcap_stat ps;
+        if (pcap_stats(pds.at(i), &ps) == 0)
+            stats.numDropped = ps.ps_drop;
+        return true;
+    }
+#endif
+    return false;
+}
+
 #ifdef HAVE_PCAP
 static void packet_handler(u_char *user, const struct pcap_pkthdr *hdr, const u_char *bytes)
 {
@@ -178,13 +210,17 @@ static void packet_handler(u_char *user, const struct pcap_pkthdr *hdr, const u_
     datalink = cSocketRTScheduler::datalinks.at(i);
     headerLength = cSocketRTScheduler::headerLengths.at(i);
     module = cSocketRTScheduler::modules.at(i);
+    cSocketRTScheduler::CaptureStats& stats = cSocketRTScheduler::captureStats.at(i);
 
     // skip ethernet frames not encapsulating an IP packet.
     if (datalink == DLT_EN10MB)
     {
         ethernet_hdr = (struct ether_header *)bytes;
         if (ntohs(ethernet_hdr->ether_type) != ETHERTYPE_IP)
+        {
+            stats.numSkipped++;
             return;
+        }
     }
 
     // put the IP packet from wire into data[] array of ExtFrame
@@ -195,14 +231,29 @@ static void packet_handler(u_char *user, const struct pcap_pkthdr *hdr, const u_
 
     // signalize new incoming packet to the interface via cMessage
     EV << "Captured " << hdr->caplen - headerLength << " bytes for an IP packet.\n";
-    timeval curTime;
+
+    // packets of a burst may have waited in the capture buffer: use the time
+    // the kernel captured them, but never schedule into the past
+    timeval curTime, captureTime;
     gettimeofday(&curTime, NULL);
-    curTime = timeval_substract(curTime, cSocketRTScheduler::baseTime);
-    simtime_t t = curTime.tv_sec + curTime.tv_usec*1e-6;
-    // TBD assert that it's somehow not smaller than previous event's time
+    captureTime.tv_sec = hdr->ts.tv_sec;
+    captureTime.tv_usec = hdr->ts.tv_usec;
+    if (timeval_greater(captureTime, curTime))
+        captureTime = curTime;
+    timeval latency = timeval_substract(curTime, captureTime);
+    captureTime = timeval_substract(captureTime, cSocketRTScheduler::baseTime);
+    simtime_t t = captureTime.tv_sec + captureTime.tv_usec*1e-6;
+    if (t < simulation.getSimTime())
+        t = simulation.getSimTime();
     notificationMsg->setArrival(module, -1, t);
 
     simulation.msgQueue.insert(notificationMsg);
+
+    simtime_t latencyTime = latency.tv_sec + latency.tv_usec*1e-6;
+    stats.numCaptured++;
+    stats.totalLatency += latencyTime;
+    if (latencyTime > stats.maxLatency)
+        stats.maxLatency = latencyTime;
 }
 #endif
 
@@ -213,7 +264,7 @@ bool cSocketRTScheduler::receiveWithTimeout()
 #ifdef HAVE_PCAP
     int32 n;
 #ifdef LINUX
-    int32 fd[FD_SETSIZE], maxfd;
+    int32 maxfd;
     fd_set rdfds;
 #endif
 #endif
@@ -225,12 +276,11 @@ bool cSocketRTScheduler::receiveWithTimeout()
 #ifdef LINUX
     FD_ZERO(&rdfds);
     maxfd = -1;
-    for (uint16 i = 0; i < pds.size(); i++)
+    for (uint16 i = 0; i < selectableFds.size(); i++)
     {
-        fd[i] = pcap_get_selectable_fd(pds.at(i));
-        if (fd[i] > maxfd)
-            maxfd = fd[i];
-        FD_SET(fd[i], &rdfds);
+        if (selectableFds[i] > maxfd)
+            maxfd = selectableFds[i];
+        FD_SET(selectableFds[i], &rdfds);
     }
     if (select(maxfd + 1, &rdfds, NULL, NULL, &timeout) < 0)
     {
@@ -240,13 +290,17 @@ bool cSocketRTScheduler::receiveWithTimeout()
     for (uint16 i = 0; i < pds.size(); i++)
     {
 #ifdef LINUX
-        if (!(FD_ISSET(fd[i], &rdfds)))
+        if (!(FD_ISSET(selectableFds[i], &rdfds)))
             continue;
 #endif
-        if ((n = pcap_dispatch(pds.at(i), 1, packet_handler, (uint8 *)&i)) < 0)
+        // drain up to PCAP_BURST packets at once instead of one per select()
+        if ((n = pcap_dispatch(pds.at(i), PCAP_BURST, packet_handler, (uint8 *)&i)) < 0)
             throw cRuntimeError("cSocketRTScheduler::pcap_dispatch(): An error occured: %s", pcap_geterr(pds.at(i)));
         if (n > 0)
+        {
+            captureStats.at(i).numBursts++;
             found = true;
+        }
     }
 #ifndef LINUX
     if (!found)
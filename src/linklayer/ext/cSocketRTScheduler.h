@@ -38,6 +38,22 @@
 
 class cSocketRTScheduler : public cScheduler
 {
+    public:
+        /**
+         * Capture counters of one interface, see getCaptureStats().
+         */
+        struct CaptureStats
+        {
+            unsigned long numCaptured;      // IP packets inserted into the FES
+            unsigned long numSkipped;       // non-IP frames ignored
+            unsigned long numDropped;       // dropped by pcap/the kernel (pcap_stats)
+            unsigned long numBursts;        // pcap_dispatch() calls that returned packets
+            simtime_t maxLatency;           // max. time between capture and insertion into the FES
+            simtime_t totalLatency;         // sum of these times, for computing the mean
+
+            CaptureStats() : numCaptured(0), numSkipped(0), numDropped(0), numBursts(0) {}
+        };
+
     protected:
         int fd;
 
@@ -58,6 +74,8 @@ class cSocketRTScheduler : public cScheduler
         static std::vector<pcap_t *> pds;
         static std::vector<int> datalinks;
         static std::vector<int> headerLengths;
+        static std::vector<int> selectableFds;
+        static std::vector<CaptureStats> captureStats;
 #endif
         static timeval baseTime;
 
@@ -83,6 +101,12 @@ class cSocketRTScheduler : public cScheduler
          */
         void setInterfaceModule(cModule *mod, const char *dev, const char *filter);
 
+        /**
+         * Returns the capture counters of the interface registered by the
+         * given module. Returns false if the module has no interface.
+         */
+        bool getCaptureStats(cModule *mod, CaptureStats& stats);
+
 #if OMNETPP_VERSION >= 0x0500
         /**
          * Returns the first event in the Future Event Set.
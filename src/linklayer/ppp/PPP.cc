@@ -63,6 +63,7 @@ void PPP::initialize(int stage)
         endTransmissionEvent = new cMessage("pppEndTxEvent");
 
         txQueueLimit = par("txQueueLimit");
+        txQueue.setCapacity(txQueueLimit);
 
         interfaceEntry = NULL;
 
@@ -325,7 +326,7 @@ void PPP::handleMessage(cMessage *msg)
 
         if (!txQueue.empty())
         {
-            cPacket *pk = (cPacket *)txQueue.pop();
+            cPacket *pk = txQueue.pop();
             startTransmitting(pk);
         }
         else if (queueModule && 0 == queueModule->getNumPendingRequests())
@@ -390,13 +391,14 @@ void PPP::handleMessage(cMessage *msg)
                 if (ev.isGUI() && txQueue.length() >= 3)
                     getDisplayString().setTagArg("i", 1, "red");
 
-                if (txQueueLimit && txQueue.length() > txQueueLimit)
+                cPacket *pk = PK(msg);
+                if (txQueue.wouldOverflow(pk))
                     error("txQueue length exceeds %d -- this is probably due to "
                           "a bogus app model generating excessive traffic "
                           "(or if this is normal, increase txQueueLimit!)",
                           txQueueLimit);
 
-                txQueue.insert(msg);
+                txQueue.insert(pk);
             }
             else
             {
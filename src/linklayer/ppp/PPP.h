@@ -24,6 +24,7 @@
 #include "PPPFrame_m.h"
 #include "TxNotifDetails.h"
 #include "INotifiable.h"
+#include "PacketQueue.h"
 
 class InterfaceEntry;
 class IPassiveQueue;
@@ -39,7 +40,7 @@ class INET_API PPP : public cSimpleModule, public INotifiable, public cListener
     cGate *physOutGate;
     cChannel *datarateChannel; // NULL if we're not connected
 
-    cQueue txQueue;
+    PacketQueue txQueue;
     cMessage *endTransmissionEvent;
     IPassiveQueue *queueModule;
 
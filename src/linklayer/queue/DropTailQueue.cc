@@ -18,12 +18,22 @@
 
 #include "INETDefs.h"
 
+#ifdef WITH_IPv4
+#include "IPv4Datagram.h"
+#endif
+
+#ifdef WITH_IPv6
+#include "IPv6Datagram.h"
+#endif
+
+#include "ECN_m.h"
 #include "DropTailQueue.h"
 
 
 Define_Module(DropTailQueue);
 
 simsignal_t DropTailQueue::queueLengthSignal = SIMSIGNAL_NULL;
+simsignal_t DropTailQueue::markPkSignal = SIMSIGNAL_NULL;
 
 void DropTailQueue::initialize()
 {
@@ -34,23 +44,37 @@ void DropTailQueue::initialize()
     //statistics
     queueLengthSignal = registerSignal("queueLength");
     emit(queueLengthSignal, queue.length());
+    markPkSignal = registerSignal("markPk");
 
     outGate = gate("out");
 
     // configuration
-    frameCapacity = par("frameCapacity");
+    queue.setCapacity(par("frameCapacity").longValue(), par("byteCapacity").longValue());
+    ecnMarkingThreshold = par("ecnMarkingThreshold");
 }
 
 cMessage *DropTailQueue::enqueue(cMessage *msg)
 {
-    if (frameCapacity && queue.length() >= frameCapacity)
+    cPacket *packet = check_and_cast<cPacket *>(msg);
+
+    if (queue.wouldOverflow(packet))
     {
         EV << "Queue full, dropping packet.\n";
         return msg;
     }
     else
     {
-        queue.insert(msg);
+        // threshold marking on the instantaneous queue length, as used by DCTCP
+        if (ecnMarkingThreshold && queue.length() >= ecnMarkingThreshold)
+        {
+            if (markCongestionExperienced(packet))
+            {
+                EV << "Queue length " << queue.length() << " >= ecnMarkingThreshold, marking packet with CE.\n";
+                emit(markPkSignal, packet);
+            }
+        }
+
+        queue.insert(packet);
         emit(queueLengthSignal, queue.length());
         return NULL;
     }
@@ -61,7 +85,7 @@ cMessage *DropTailQueue::dequeue()
     if (queue.empty())
         return NULL;
 
-    cMessage *msg = (cMessage *)queue.pop();
+    cMessage *msg = queue.pop();
 
     // statistics
     emit(queueLengthSignal, queue.length());
@@ -79,3 +103,32 @@ bool DropTailQueue::isEmpty()
     return queue.empty();
 }
 
+bool DropTailQueue::markCongestionExperienced(cPacket *packet)
+{
+    for ( ; packet; packet = packet->getEncapsulatedPacket())
+    {
+#ifdef WITH_IPv4
+        IPv4Datagram *ipv4Datagram = dynamic_cast<IPv4Datagram *>(packet);
+        if (ipv4Datagram)
+        {
+            if (ipv4Datagram->getExplicitCongestionNotification() == IP_ECN_NOT_ECT)
+                return false;
+            ipv4Datagram->setExplicitCongestionNotification(IP_ECN_CE);
+            return true;
+        }
+#endif
+#ifdef WITH_IPv6
+        IPv6Datagram *ipv6Datagram = dynamic_cast<IPv6Datagram *>(packet);
+        if (ipv6Datagram)
+        {
+            if (ipv6Datagram->getExplicitCongestionNotification() == IP_ECN_NOT_ECT)
+                return false;
+            ipv6Datagram->setExplicitCongestionNotification(IP_ECN_CE);
+            return true;
+        }
+#endif
+    }
+
+    return false;
+}
+
@@ -22,6 +22,7 @@
 #include "INETDefs.h"
 
 #include "PassiveQueueBase.h"
+#include "PacketQueue.h"
 
 /**
  * Drop-front queue. See NED for more info.
@@ -30,14 +31,15 @@ class INET_API DropTailQueue : public PassiveQueueBase
 {
   protected:
     // configuration
-    int frameCapacity;
+    int ecnMarkingThreshold;
 
     // state
-    cQueue queue;
+    PacketQueue queue;
     cGate *outGate;
 
     // statistics
     static simsignal_t queueLengthSignal;
+    static simsignal_t markPkSignal;
 
   protected:
     virtual void initialize();
@@ -57,6 +59,12 @@ class INET_API DropTailQueue : public PassiveQueueBase
      */
     virtual void sendOut(cMessage *msg);
 
+    /**
+     * Sets the ECN field of the IPv4/IPv6 datagram carried in the packet
+     * to CE if it is ECN-capable. Returns true if the packet was marked.
+     */
+    virtual bool markCongestionExperienced(cPacket *packet);
+
     /**
      * Redefined from IPassiveQueue.
      */
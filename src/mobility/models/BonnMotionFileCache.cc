@@ -16,21 +16,22 @@
 //
 
 
+#include <cstdlib>
 #include <fstream>
-#include <sstream>
 
 #include "BonnMotionFileCache.h"
 
 
 const BonnMotionFile::Line *BonnMotionFile::getLine(int nodeId) const
 {
-    LineList::const_iterator it = lines.begin();
-    for (int i=0; i<nodeId && it!=lines.end(); i++) it++;
-    return (it==lines.end()) ? NULL : &(*it);
+    if (nodeId < 0 || nodeId >= (int)lines.size())
+        return NULL;
+    return &lines[nodeId];
 }
 
 
 BonnMotionFileCache *BonnMotionFileCache::inst;
+int BonnMotionFileCache::numUsers;
 
 BonnMotionFileCache *BonnMotionFileCache::getInstance()
 {
@@ -48,6 +49,19 @@ void BonnMotionFileCache::deleteInstance()
     }
 }
 
+BonnMotionFileCache *BonnMotionFileCache::acquireInstance()
+{
+    numUsers++;
+    return getInstance();
+}
+
+void BonnMotionFileCache::releaseInstance()
+{
+    ASSERT(numUsers > 0);
+    if (--numUsers == 0)
+        deleteInstance();
+}
+
 const BonnMotionFile *BonnMotionFileCache::getFile(const char *filename)
 {
     // if found, return it from cache
@@ -73,10 +87,18 @@ void BonnMotionFileCache::parseFile(const char *filename, BonnMotionFile& bmFile
         bmFile.lines.push_back(BonnMotionFile::Line());
         BonnMotionFile::Line& vec = bmFile.lines.back();
 
-        std::stringstream linestream(line);
-        double d;
-        while (linestream >> d)
+        // strtod() is much faster than reading numbers from a stringstream,
+        // which matters for traces with thousands of nodes
+        const char *s = line.c_str();
+        char *end;
+        while (true)
+        {
+            double d = strtod(s, &end);
+            if (end == s)
+                break;
             vec.push_back(d);
+            s = end;
+        }
     }
     in.close();
 }
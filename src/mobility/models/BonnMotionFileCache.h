@@ -19,7 +19,7 @@
 #ifndef BONN_MOTION_FILE_CACHE_H
 #define BONN_MOTION_FILE_CACHE_H
 
-#include <list>
+#include <deque>
 #include <vector>
 
 #include "INETDefs.h"
@@ -37,9 +37,10 @@ class INET_API BonnMotionFile
     typedef std::vector<double> Line;
   protected:
     friend class BonnMotionFileCache;
-    typedef std::list<Line> LineList;
+    typedef std::deque<Line> LineList;  // deque: appending does not copy the previous lines
     LineList lines;
   public:
+    /** Returns the line of the given node in constant time, or NULL if there is no such line. */
     const Line *getLine(int nodeId) const;
 };
 
@@ -58,6 +59,7 @@ class INET_API BonnMotionFileCache
     typedef std::map<std::string,BonnMotionFile> BMFileMap;
     BMFileMap cache;
     static BonnMotionFileCache *inst;
+    static int numUsers;
     void parseFile(const char *filename, BonnMotionFile& bmFile);
     BonnMotionFileCache() {}
     virtual ~BonnMotionFileCache() {}
@@ -73,6 +75,18 @@ class INET_API BonnMotionFileCache
      */
     static void deleteInstance();
 
+    /**
+     * Returns the singleton instance, and counts the caller as its user
+     * until the matching releaseInstance() call.
+     */
+    static BonnMotionFileCache *acquireInstance();
+
+    /**
+     * Ends a use begun with acquireInstance(). Deletes the singleton
+     * instance when its last user releases it.
+     */
+    static void releaseInstance();
+
     /**
      * Returns the given document.
      */
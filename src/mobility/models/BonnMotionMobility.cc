@@ -28,12 +28,15 @@ BonnMotionMobility::BonnMotionMobility()
 {
     is3D = false;
     lines = NULL;
+    cacheAcquired = false;
     currentLine = -1;
 }
 
 BonnMotionMobility::~BonnMotionMobility()
 {
-    BonnMotionFileCache::deleteInstance();
+    // other nodes may still use the cached file, the last one deletes it
+    if (cacheAcquired)
+        BonnMotionFileCache::releaseInstance();
 }
 
 void BonnMotionMobility::initialize(int stage)
@@ -47,7 +50,9 @@ void BonnMotionMobility::initialize(int stage)
         if (nodeId == -1)
             nodeId = getParentModule()->getIndex();
         const char *fname = par("traceFile");
-        const BonnMotionFile *bmFile = BonnMotionFileCache::getInstance()->getFile(fname);
+        BonnMotionFileCache *cache = BonnMotionFileCache::acquireInstance();
+        cacheAcquired = true;
+        const BonnMotionFile *bmFile = cache->getFile(fname);
         lines = bmFile->getLine(nodeId);
         if (!lines)
             throw cRuntimeError("Invalid nodeId %d -- no such line in file '%s'", nodeId, fname);
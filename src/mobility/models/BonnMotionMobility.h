@@ -35,7 +35,8 @@ class INET_API BonnMotionMobility : public LineSegmentsMobilityBase
   protected:
     // state
     bool is3D;
-    const BonnMotionFile::Line *lines;
+    const BonnMotionFile::Line *lines;  // points into the file cache
+    bool cacheAcquired;  // whether the file cache must be released
     int currentLine;
 
   protected:
@@ -0,0 +1,76 @@
+//
+// This library is free software, you can redistribute it
+// and/or modify
+// it under  the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation;
+// either version 2 of the License, or any later version.
+// The library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU Lesser General Public License for more details.
+//
+
+#include <algorithm>
+
+#include "MobilityManager.h"
+#include "MovingMobilityBase.h"
+
+
+Define_Module(MobilityManager);
+
+MobilityManager::MobilityManager()
+{
+    updateTimer = NULL;
+}
+
+MobilityManager::~MobilityManager()
+{
+    cancelAndDelete(updateTimer);
+}
+
+MobilityManager *MobilityManager::findMobilityManager()
+{
+    return dynamic_cast<MobilityManager *>(simulation.getModuleByPath("mobilityManager"));
+}
+
+MobilityManager *MobilityManager::getMobilityManager()
+{
+    MobilityManager *mobilityManager = findMobilityManager();
+    if (!mobilityManager)
+        throw cRuntimeError("Could not find MobilityManager module with name 'mobilityManager' in the toplevel network.");
+    return mobilityManager;
+}
+
+void MobilityManager::initialize()
+{
+    updateTimer = new cMessage("update");
+    updateInterval = par("updateInterval");
+    WATCH(updateInterval);
+    if (updateInterval != 0)
+        scheduleAt(simTime() + updateInterval, updateTimer);
+}
+
+void MobilityManager::handleMessage(cMessage *message)
+{
+    if (message != updateTimer)
+        throw cRuntimeError("This module doesn't process messages");
+
+    // a mobility module may unregister while being updated, so index the vector
+    for (unsigned int i = 0; i < mobilities.size(); i++)
+        mobilities[i]->updateFromManager();
+    scheduleAt(simTime() + updateInterval, updateTimer);
+}
+
+void MobilityManager::registerMobility(MovingMobilityBase *mobility)
+{
+    Enter_Method_Silent();
+    mobilities.push_back(mobility);
+}
+
+void MobilityManager::unregisterMobility(MovingMobilityBase *mobility)
+{
+    Enter_Method_Silent();
+    std::vector<MovingMobilityBase *>::iterator it = std::find(mobilities.begin(), mobilities.end(), mobility);
+    if (it != mobilities.end())
+        mobilities.erase(it);
+}
@@ -0,0 +1,67 @@
+//
+// This library is free software, you can redistribute it
+// and/or modify
+// it under  the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation;
+// either version 2 of the License, or any later version.
+// The library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU Lesser General Public License for more details.
+//
+
+#ifndef MOBILITY_MANAGER_H
+#define MOBILITY_MANAGER_H
+
+#include <vector>
+
+#include "INETDefs.h"
+
+class MovingMobilityBase;
+
+
+/**
+ * @brief Signals the mobility state of many mobility modules periodically with a single timer.
+ *
+ * Mobility modules with useMobilityManager=true register here instead of scheduling
+ * their own periodic update timers; they only schedule events for their own mobility
+ * state changes (e.g. the end of a line segment). See the NED documentation for details.
+ *
+ * @ingroup mobility
+ */
+class INET_API MobilityManager : public cSimpleModule
+{
+  protected:
+    /** @brief The registered mobility modules in registration order. */
+    std::vector<MovingMobilityBase *> mobilities;
+
+    /** @brief The simulation time interval of the periodic updates. */
+    simtime_t updateInterval;
+
+    /** @brief The message used for the periodic updates. */
+    cMessage *updateTimer;
+
+  protected:
+    virtual void initialize();
+
+    virtual void handleMessage(cMessage *message);
+
+  public:
+    MobilityManager();
+
+    virtual ~MobilityManager();
+
+    /** @brief Returns the mobility manager module of the network; throws an error if there is none. */
+    static MobilityManager *getMobilityManager();
+
+    /** @brief Returns the mobility manager module of the network, or NULL. */
+    static MobilityManager *findMobilityManager();
+
+    /** @brief Adds a mobility module to the periodic updates. */
+    void registerMobility(MovingMobilityBase *mobility);
+
+    /** @brief Removes a mobility module from the periodic updates. */
+    void unregisterMobility(MovingMobilityBase *mobility);
+};
+
+#endif
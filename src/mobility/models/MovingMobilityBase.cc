@@ -22,6 +22,7 @@
 
 
 #include "MovingMobilityBase.h"
+#include "MobilityManager.h"
 
 
 MovingMobilityBase::MovingMobilityBase()
@@ -32,11 +33,19 @@ MovingMobilityBase::MovingMobilityBase()
     lastSpeed = Coord::ZERO;
     lastUpdate = 0;
     nextChange = -1;
+    mobilityManager = NULL;
 }
 
 MovingMobilityBase::~MovingMobilityBase()
 {
     cancelAndDelete(moveTimer);
+    if (mobilityManager)
+    {
+        // check if the mobility manager still exists
+        MobilityManager *manager = MobilityManager::findMobilityManager();
+        if (manager)
+            manager->unregisterMobility(this);
+    }
 }
 
 void MovingMobilityBase::initialize(int stage)
@@ -46,9 +55,13 @@ void MovingMobilityBase::initialize(int stage)
     if (stage == 0) {
         moveTimer = new cMessage("move");
         updateInterval = par("updateInterval");
+        if (par("useMobilityManager").boolValue())
+            mobilityManager = MobilityManager::getMobilityManager();
     }
     else if (stage == 2) {
         lastUpdate = simTime();
+        if (mobilityManager)
+            mobilityManager->registerMobility(this);
         scheduleUpdate();
     }
 }
@@ -64,6 +77,13 @@ void MovingMobilityBase::moveAndUpdate()
     }
 }
 
+void MovingMobilityBase::updateFromManager()
+{
+    Enter_Method_Silent();
+    if (!stationary)
+        moveAndUpdate();
+}
+
 void MovingMobilityBase::handleSelfMessage(cMessage *message)
 {
     moveAndUpdate();
@@ -73,7 +93,7 @@ void MovingMobilityBase::handleSelfMessage(cMessage *message)
 void MovingMobilityBase::scheduleUpdate()
 {
     cancelEvent(moveTimer);
-    if (!stationary && updateInterval != 0) {
+    if (!stationary && updateInterval != 0 && !mobilityManager) {
         // periodic update is needed
         simtime_t nextUpdate = simTime() + updateInterval;
         if (nextChange != -1 && nextChange < nextUpdate)
@@ -84,7 +104,7 @@ void MovingMobilityBase::scheduleUpdate()
             scheduleAt(nextUpdate, moveTimer);
     }
     else if (nextChange != -1)
-        // no periodic update is needed
+        // no periodic update is needed, or the mobility manager does it
         scheduleAt(nextChange, moveTimer);
 }
 
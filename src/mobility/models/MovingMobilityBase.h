@@ -27,6 +27,7 @@
 
 #include "MobilityBase.h"
 
+class MobilityManager;
 
 /**
  * @brief Base class for moving mobility modules. Periodically emits a signal with the current mobility state.
@@ -61,6 +62,9 @@ class INET_API MovingMobilityBase : public MobilityBase
      * The -1 value turns off sending a self message for the next mobility state change. */
     simtime_t nextChange;
 
+    /** @brief The mobility manager that does the periodic updates instead of moveTimer, or NULL. */
+    MobilityManager *mobilityManager;
+
   protected:
     MovingMobilityBase();
 
@@ -91,6 +95,9 @@ class INET_API MovingMobilityBase : public MobilityBase
 
     /** @brief Returns the current speed at the current simulation time. */
     virtual Coord getCurrentSpeed();
+
+    /** @brief Called by the MobilityManager for the periodic update: moves and notifies listeners unless stationary. */
+    virtual void updateFromManager();
 };
 
 #endif
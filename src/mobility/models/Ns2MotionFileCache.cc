@@ -0,0 +1,130 @@
+//
+// This library is free software, you can redistribute it
+// and/or modify
+// it under  the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation;
+// either version 2 of the License, or any later version.
+// The library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU Lesser General Public License for more details.
+//
+
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "Ns2MotionFileCache.h"
+
+
+Ns2MotionFileCache *Ns2MotionFileCache::inst;
+int Ns2MotionFileCache::numUsers;
+
+Ns2MotionFileCache *Ns2MotionFileCache::getInstance()
+{
+    if (!inst)
+        inst = new Ns2MotionFileCache;
+    return inst;
+}
+
+void Ns2MotionFileCache::deleteInstance()
+{
+    if (inst)
+    {
+        delete inst;
+        inst = NULL;
+    }
+}
+
+Ns2MotionFileCache *Ns2MotionFileCache::acquireInstance()
+{
+    numUsers++;
+    return getInstance();
+}
+
+void Ns2MotionFileCache::releaseInstance()
+{
+    ASSERT(numUsers > 0);
+    if (--numUsers == 0)
+        deleteInstance();
+}
+
+const Ns2MotionFile *Ns2MotionFileCache::getFile(const char *filename, int nodeId)
+{
+    FileMap::iterator it = cache.find(std::string(filename));
+    if (it == cache.end())
+    {
+        // load and store in cache
+        it = cache.insert(std::make_pair(std::string(filename), NodeMap())).first;
+        parseFile(filename, it->second);
+    }
+
+    NodeMap::const_iterator node = it->second.find(nodeId);
+    return node == it->second.end() ? NULL : &node->second;
+}
+
+void Ns2MotionFileCache::parseFile(const char *filename, NodeMap& nodes)
+{
+    std::ifstream in(filename, std::ios::in);
+    if (in.fail())
+        throw cRuntimeError("Cannot open file '%s'", filename);
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        // '#' line
+        std::string::size_type found = line.find('#');
+        if (found == 0)
+            continue;
+        found = line.find("$node_");
+        if (found == std::string::npos)
+            continue;
+
+        // Node Id
+        std::string::size_type pos1 = line.find('(');
+        std::string::size_type pos2 = line.find(')');
+        if (pos1 == std::string::npos || pos2 == std::string::npos || pos2 - pos1 <= 1)
+            continue;
+        int nodeId = std::atoi(line.c_str() + pos1 + 1);
+        Ns2MotionFile& ns2File = nodes[nodeId];
+
+        found = line.find("set ");
+        if (found != std::string::npos)
+        {
+            // Initial position
+            found = line.find("X_");
+            if (found != std::string::npos)
+                ns2File.initial[0] = std::atof(line.c_str() + found + 3);
+            found = line.find("Y_");
+            if (found != std::string::npos)
+                ns2File.initial[1] = std::atof(line.c_str() + found + 3);
+            found = line.find("Z_");
+            if (found != std::string::npos)
+                ns2File.initial[2] = std::atof(line.c_str() + found + 3);
+        }
+
+        found = line.find("setdest");
+        if (found != std::string::npos)
+        {
+            ns2File.lines.push_back(Ns2MotionFile::Line());
+            Ns2MotionFile::Line& vec = ns2File.lines.back();
+            // initial time
+            std::string::size_type at = line.find("at");
+            vec.push_back(std::atof(line.c_str() + at + 3));
+
+            // destination and speed; strtod() is much faster than a stringstream
+            const char *s = line.c_str() + found + 7;
+            char *end;
+            while (true)
+            {
+                double d = std::strtod(s, &end);
+                if (end == s)
+                    break;
+                vec.push_back(d);
+                s = end;
+            }
+        }
+    }
+    in.close();
+}
@@ -0,0 +1,94 @@
+//
+// This library is free software, you can redistribute it
+// and/or modify
+// it under  the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation;
+// either version 2 of the License, or any later version.
+// The library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU Lesser General Public License for more details.
+//
+
+#ifndef NS2_MOTION_FILE_CACHE_H
+#define NS2_MOTION_FILE_CACHE_H
+
+#include <map>
+#include <vector>
+
+#include "INETDefs.h"
+
+
+class Ns2MotionFileCache;
+class Ns2MotionMobility;
+
+/**
+ * Represents the part of an ns2 motion file that describes one node:
+ * its initial position and its "setdest" commands.
+ * @see Ns2MotionFileCache, Ns2MotionMobility
+ */
+class INET_API Ns2MotionFile
+{
+  public:
+    typedef std::vector<double> Line;
+    double initial[3];
+  protected:
+    friend class Ns2MotionFileCache;
+    friend class Ns2MotionMobility;
+    typedef std::vector<Line> LineList;
+    LineList lines;
+  public:
+    Ns2MotionFile() { initial[0] = initial[1] = initial[2] = -1; }
+};
+
+
+/**
+ * Singleton object to read and store ns2 motion files. Used within
+ * Ns2MotionMobility. Each file is parsed once and split by node, instead
+ * of every node reading the whole file to pick out its own lines.
+ *
+ * @ingroup mobility
+ */
+class INET_API Ns2MotionFileCache
+{
+  protected:
+    typedef std::map<int,Ns2MotionFile> NodeMap;
+    typedef std::map<std::string,NodeMap> FileMap;
+    FileMap cache;
+    static Ns2MotionFileCache *inst;
+    static int numUsers;
+    void parseFile(const char *filename, NodeMap& nodes);
+    Ns2MotionFileCache() {}
+    virtual ~Ns2MotionFileCache() {}
+
+  public:
+    /**
+     * Returns the singleton instance.
+     */
+    static Ns2MotionFileCache *getInstance();
+
+    /**
+     * Deletes the singleton instance.
+     */
+    static void deleteInstance();
+
+    /**
+     * Returns the singleton instance, and counts the caller as its user
+     * until the matching releaseInstance() call.
+     */
+    static Ns2MotionFileCache *acquireInstance();
+
+    /**
+     * Ends a use begun with acquireInstance(). Deletes the singleton
+     * instance when its last user releases it.
+     */
+    static void releaseInstance();
+
+    /**
+     * Returns the motion of the given node from the given file, or NULL
+     * if the file does not mention the node.
+     */
+    virtual const Ns2MotionFile *getFile(const char *filename, int nodeId);
+};
+
+#endif
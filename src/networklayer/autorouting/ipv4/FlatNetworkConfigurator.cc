@@ -23,47 +23,58 @@
 #include "InterfaceEntry.h"
 #include "IPv4InterfaceData.h"
 
-#if OMNETPP_VERSION < 0x0403
-#include "WeightedTopology.h"
-#else
-typedef cTopology WeightedTopology;
-#endif
-
 
 Define_Module(FlatNetworkConfigurator);
 
+static double printElapsedTime(const char *name, long startTime)
+{
+    double elapsed = (double)(clock() - startTime) / CLOCKS_PER_SEC;
+    EV << "Time spent in FlatNetworkConfigurator::" << name << ": " << elapsed << "s" << endl;
+    return elapsed;
+}
+
+#define T(CODE)  {long startTime=clock(); CODE; printElapsedTime(#CODE, startTime);}
+
 
 void FlatNetworkConfigurator::initialize(int stage)
 {
     if (stage==2)
     {
-        WeightedTopology topo("topo");
+        long initializeStartTime = clock();
+
+        Topology topo("topo");
         NodeInfoVector nodeInfo; // will be of size topo.nodes[]
 
-        // extract topology into the cTopology object, then fill in
+        // extract topology into the Topology object, then fill in
         // isIPNode, rt and ift members of nodeInfo[]
+        long extractStartTime = clock();
         extractTopology(topo, nodeInfo);
+        recordScalar("topology extraction time", printElapsedTime("extractTopology", extractStartTime), "s");
 
         // assign addresses to IPv4 nodes, and also store result in nodeInfo[].address
-        assignAddresses(topo, nodeInfo);
+        T(assignAddresses(topo, nodeInfo));
 
         // add default routes to hosts (nodes with a single attachment);
         // also remember result in nodeInfo[].usesDefaultRoute
-        addDefaultRoutes(topo, nodeInfo);
+        T(addDefaultRoutes(topo, nodeInfo));
 
         // calculate shortest paths, and add corresponding static routes
-        fillRoutingTables(topo, nodeInfo);
+        T(fillRoutingTables(topo, nodeInfo));
 
         // update display string
         setDisplayString(topo, nodeInfo);
+
+        recordScalar("initialization time", printElapsedTime("initialize", initializeStartTime), "s");
     }
 }
 
-void FlatNetworkConfigurator::extractTopology(cTopology& topo, NodeInfoVector& nodeInfo)
+#undef T
+
+void FlatNetworkConfigurator::extractTopology(Topology& topo, NodeInfoVector& nodeInfo)
 {
     // extract topology
     topo.extractByProperty("node");
-    EV << "cTopology found " << topo.getNumNodes() << " nodes\n";
+    EV << "Topology found " << topo.getNumNodes() << " nodes\n";
 
     // fill in isIPNode, ift and rt members in nodeInfo[]
     nodeInfo.resize(topo.getNumNodes());
@@ -81,7 +92,7 @@ void FlatNetworkConfigurator::extractTopology(cTopology& topo, NodeInfoVector& n
     }
 }
 
-void FlatNetworkConfigurator::assignAddresses(cTopology& topo, NodeInfoVector& nodeInfo)
+void FlatNetworkConfigurator::assignAddresses(Topology& topo, NodeInfoVector& nodeInfo)
 {
     // assign IPv4 addresses
     uint32 networkAddress = IPv4Address(par("networkAddress").stringValue()).getInt();
@@ -114,12 +125,12 @@ void FlatNetworkConfigurator::assignAddresses(cTopology& topo, NodeInfoVector& n
     }
 }
 
-void FlatNetworkConfigurator::addDefaultRoutes(cTopology& topo, NodeInfoVector& nodeInfo)
+void FlatNetworkConfigurator::addDefaultRoutes(Topology& topo, NodeInfoVector& nodeInfo)
 {
     // add default route to nodes with exactly one (non-loopback) interface
     for (int i=0; i<topo.getNumNodes(); i++)
     {
-        cTopology::Node *node = topo.getNode(i);
+        Topology::Node *node = topo.getNode(i);
 
         // skip bus types
         if (!nodeInfo[i].isIPNode)
@@ -153,13 +164,12 @@ void FlatNetworkConfigurator::addDefaultRoutes(cTopology& topo, NodeInfoVector&
     }
 }
 
-void FlatNetworkConfigurator::fillRoutingTables(cTopology& _topo, NodeInfoVector& nodeInfo)
+void FlatNetworkConfigurator::fillRoutingTables(Topology& topo, NodeInfoVector& nodeInfo)
 {
-    WeightedTopology &topo = (WeightedTopology &)_topo;
     // fill in routing tables with static routes
     for (int i=0; i<topo.getNumNodes(); i++)
     {
-        cTopology::Node *destNode = topo.getNode(i);
+        Topology::Node *destNode = topo.getNode(i);
 
         // skip bus types
         if (!nodeInfo[i].isIPNode)
@@ -179,7 +189,7 @@ void FlatNetworkConfigurator::fillRoutingTables(cTopology& _topo, NodeInfoVector
             if (!nodeInfo[j].isIPNode)
                 continue;
 
-            cTopology::Node *atNode = topo.getNode(j);
+            Topology::Node *atNode = topo.getNode(j);
             if (atNode->getNumPaths()==0)
                 continue; // not connected
             if (nodeInfo[j].usesDefaultRoute)
@@ -215,7 +225,7 @@ void FlatNetworkConfigurator::handleMessage(cMessage *msg)
     error("this module doesn't handle messages, it runs only in initialize()");
 }
 
-void FlatNetworkConfigurator::setDisplayString(cTopology& topo, NodeInfoVector& nodeInfo)
+void FlatNetworkConfigurator::setDisplayString(Topology& topo, NodeInfoVector& nodeInfo)
 {
     int numIPNodes = 0;
     for (int i=0; i<topo.getNumNodes(); i++)
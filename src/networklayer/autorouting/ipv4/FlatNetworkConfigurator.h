@@ -21,6 +21,7 @@
 #include "INETDefs.h"
 
 #include "IPv4Address.h"
+#include "Topology.h"
 
 class IInterfaceTable;
 class IRoutingTable;
@@ -52,12 +53,12 @@ class INET_API FlatNetworkConfigurator : public cSimpleModule
     virtual void initialize(int stage);
     virtual void handleMessage(cMessage *msg);
 
-    virtual void extractTopology(cTopology& topo, NodeInfoVector& nodeInfo);
-    virtual void assignAddresses(cTopology& topo, NodeInfoVector& nodeInfo);
-    virtual void addDefaultRoutes(cTopology& topo, NodeInfoVector& nodeInfo);
-    virtual void fillRoutingTables(cTopology& topo, NodeInfoVector& nodeInfo);
+    virtual void extractTopology(Topology& topo, NodeInfoVector& nodeInfo);
+    virtual void assignAddresses(Topology& topo, NodeInfoVector& nodeInfo);
+    virtual void addDefaultRoutes(Topology& topo, NodeInfoVector& nodeInfo);
+    virtual void fillRoutingTables(Topology& topo, NodeInfoVector& nodeInfo);
 
-    virtual void setDisplayString(cTopology& topo, NodeInfoVector& nodeInfo);
+    virtual void setDisplayString(Topology& topo, NodeInfoVector& nodeInfo);
 };
 
 #endif
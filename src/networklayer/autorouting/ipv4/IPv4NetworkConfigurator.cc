@@ -19,6 +19,10 @@
 //
 
 #include <set>
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <stdio.h>
 #include "stlutils.h"
 #include "IRoutingTable.h"
 #include "IInterfaceTable.h"
@@ -73,12 +77,33 @@ void IPv4NetworkConfigurator::initialize(int stage)
         if (par("dumpLinks").boolValue())
             T(dumpLinks(topology));
 
+        // look up the addresses and static routes computed by an earlier run with the same network and configuration
+        const char *configCacheFile = par("configCacheFile");
+        uint64 configHash = 0;
+        bool configCacheHit = false;
+        ConfigCache configCache;
+        if (isNotEmpty(configCacheFile))
+        {
+            T(configHash = computeConfigHash(par("config").xmlValue(), topology));
+            T(configCacheHit = readConfigCache(configCacheFile, configHash, topology, configCache));
+            if (!configCacheHit)
+            {
+                configCache.addresses.resize(topology.getNumNodes());
+                configCache.routes.resize(topology.getNumNodes());
+            }
+        }
+
         // read the configuration from XML; it will serve as input for address assignment
         T(readAddressConfiguration(par("config").xmlValue(), topology));
 
         // assign addresses to IPv4 nodes
         if (par("assignAddresses").boolValue())
-            T(assignAddresses(topology));
+        {
+            if (configCacheHit)
+                T(applyCachedAddresses(topology, configCache))
+            else
+                T(assignAddresses(topology))
+        }
 
         // read and configure multicast groups from the XML configuration
         T(addMulticastGroups(par("config").xmlValue(), topology));
@@ -95,7 +120,34 @@ void IPv4NetworkConfigurator::initialize(int stage)
 
         // calculate shortest paths, and add corresponding static routes
         if (par("addStaticRoutes").boolValue())
-            T(addStaticRoutes(topology));
+        {
+            if (configCacheHit)
+                T(applyCachedRoutes(topology, configCache))
+            else
+            {
+                // remember the routes added so far, so that the static ones can be told apart for the cache
+                std::vector<std::set<IPv4Route *> > manualRoutes(topology.getNumNodes());
+                for (int i = 0; i < topology.getNumNodes(); i++)
+                {
+                    IRoutingTable *routingTable = ((Node *)topology.getNode(i))->routingTable;
+                    for (int j = 0; routingTable && j < routingTable->getNumRoutes(); j++)
+                        manualRoutes[i].insert(routingTable->getRoute(j));
+                }
+
+                T(addStaticRoutes(topology));
+
+                if (isNotEmpty(configCacheFile))
+                    collectStaticRoutes(topology, manualRoutes, configCache);
+            }
+        }
+
+        // store the computed configuration for later runs
+        if (isNotEmpty(configCacheFile) && !configCacheHit)
+        {
+            if (par("assignAddresses").boolValue())
+                collectAddresses(topology, configCache);
+            T(writeConfigCache(configCacheFile, configHash, configCache));
+        }
 
         // print routes to module output
         if (par("dumpRoutes").boolValue())
@@ -1026,6 +1078,313 @@ bool IPv4NetworkConfigurator::linkContainsMatchingHostExcept(LinkInfo *linkInfo,
     return false;
 }
 
+// FNV-1a, see http://www.isthe.com/chongo/tech/comp/fnv/
+static uint64 hashBytes(uint64 hash, const unsigned char *bytes, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+        hash = (hash ^ bytes[i]) * (uint64)1099511628211ULL;
+    return hash;
+}
+
+static uint64 hashString(uint64 hash, const char *s)
+{
+    if (!s)
+        s = "";
+    return hashBytes(hash, (const unsigned char *)s, strlen(s) + 1);
+}
+
+static uint64 hashInt(uint64 hash, uint32 value)
+{
+    unsigned char bytes[4] = { (unsigned char)(value >> 24), (unsigned char)(value >> 16), (unsigned char)(value >> 8), (unsigned char)value };
+    return hashBytes(hash, bytes, 4);
+}
+
+static uint64 hashDouble(uint64 hash, double value)
+{
+    char buf[32];
+    sprintf(buf, "%.17g", value);
+    return hashString(hash, buf);
+}
+
+static uint64 hashXML(uint64 hash, cXMLElement *element)
+{
+    hash = hashString(hash, element->getTagName());
+    cXMLAttributeMap attributes = element->getAttributes();
+    for (cXMLAttributeMap::iterator it = attributes.begin(); it != attributes.end(); ++it)
+    {
+        hash = hashString(hash, it->first.c_str());
+        hash = hashString(hash, it->second.c_str());
+    }
+    hash = hashString(hash, element->getNodeValue());
+    int numChildren = 0;
+    for (cXMLElement *child = element->getFirstChild(); child; child = child->getNextSibling(), numChildren++)
+        hash = hashXML(hash, child);
+    return hashInt(hash, numChildren);
+}
+
+uint64 IPv4NetworkConfigurator::computeConfigHash(cXMLElement *root, IPv4Topology& topology)
+{
+    uint64 hash = (uint64)14695981039346656037ULL;
+
+    // parameters that influence the result
+    const char *parameterNames[] = { "assignAddresses", "assignDisjunctSubnetAddresses", "addStaticRoutes", "addDefaultRoutes", "addSubnetRoutes", "optimizeRoutes", NULL };
+    for (int i = 0; parameterNames[i]; i++)
+        hash = hashString(hash, par(parameterNames[i]).str().c_str());
+    hash = hashXML(hash, root);
+
+    // nodes, their interfaces with preconfigured addresses, and the links between them
+    hash = hashInt(hash, topology.getNumNodes());
+    for (int i = 0; i < topology.getNumNodes(); i++)
+    {
+        Node *node = (Node *)topology.getNode(i);
+        hash = hashString(hash, node->module->getFullPath().c_str());
+        hash = hashDouble(hash, node->getWeight());
+        hash = hashInt(hash, node->routingTable != NULL);
+        if (node->interfaceTable)
+        {
+            hash = hashInt(hash, node->interfaceTable->getNumInterfaces());
+            for (int j = 0; j < node->interfaceTable->getNumInterfaces(); j++)
+            {
+                InterfaceEntry *interfaceEntry = node->interfaceTable->getInterface(j);
+                hash = hashString(hash, interfaceEntry->getFullName());
+                hash = hashInt(hash, interfaceEntry->getInterfaceId());
+                if (interfaceEntry->ipv4Data())
+                {
+                    hash = hashInt(hash, interfaceEntry->ipv4Data()->getIPAddress().getInt());
+                    hash = hashInt(hash, interfaceEntry->ipv4Data()->getNetmask().getInt());
+                }
+            }
+        }
+        hash = hashInt(hash, node->getNumOutLinks());
+        for (int j = 0; j < node->getNumOutLinks(); j++)
+        {
+            Topology::LinkOut *linkOut = node->getLinkOut(j);
+            hash = hashString(hash, ((Node *)linkOut->getRemoteNode())->module->getFullPath().c_str());
+            hash = hashInt(hash, linkOut->getLocalGateId());
+            hash = hashInt(hash, linkOut->getRemoteGateId());
+            hash = hashDouble(hash, linkOut->getWeight());
+        }
+    }
+
+    // LANs and wireless networks
+    hash = hashInt(hash, topology.linkInfos.size());
+    for (int i = 0; i < (int)topology.linkInfos.size(); i++)
+    {
+        LinkInfo *linkInfo = topology.linkInfos[i];
+        hash = hashInt(hash, linkInfo->interfaceInfos.size());
+        for (int j = 0; j < (int)linkInfo->interfaceInfos.size(); j++)
+            hash = hashString(hash, linkInfo->interfaceInfos[j]->getFullPath().c_str());
+    }
+    return hash;
+}
+
+static const char CONFIG_CACHE_MAGIC[8] = { 'I', 'P', 'v', '4', 'C', 'F', 'G', '1' };
+
+static void writeInt(FILE *f, uint32 value)
+{
+    unsigned char bytes[4] = { (unsigned char)(value >> 24), (unsigned char)(value >> 16), (unsigned char)(value >> 8), (unsigned char)value };
+    fwrite(bytes, 1, 4, f);
+}
+
+static bool readInt(FILE *f, uint32& value)
+{
+    unsigned char bytes[4];
+    if (fread(bytes, 1, 4, f) != 4)
+        return false;
+    value = ((uint32)bytes[0] << 24) | ((uint32)bytes[1] << 16) | ((uint32)bytes[2] << 8) | bytes[3];
+    return true;
+}
+
+bool IPv4NetworkConfigurator::readConfigCache(const char *fileName, uint64 hash, IPv4Topology& topology, ConfigCache& cache)
+{
+    FILE *f = fopen(fileName, "rb");
+    if (!f)
+    {
+        EV_INFO << "Configuration cache " << fileName << " not found\n";
+        return false;
+    }
+
+    char magic[8];
+    uint32 hashHigh, hashLow, numNodes;
+    bool ok = fread(magic, 1, 8, f) == 8 && !memcmp(magic, CONFIG_CACHE_MAGIC, 8) &&
+              readInt(f, hashHigh) && readInt(f, hashLow) && readInt(f, numNodes) &&
+              (((uint64)hashHigh << 32) | hashLow) == hash && (int)numNodes == topology.getNumNodes();
+    if (ok)
+    {
+        cache.addresses.resize(numNodes);
+        cache.routes.resize(numNodes);
+        for (uint32 i = 0; ok && i < numNodes; i++)
+        {
+            uint32 numAddresses, numRoutes, value;
+            ok = readInt(f, numAddresses);
+            for (uint32 j = 0; ok && j < numAddresses; j++)
+            {
+                ConfigCache::Address address;
+                ok = readInt(f, value) && readInt(f, address.address) && readInt(f, address.netmask);
+                address.interfaceId = value;
+                cache.addresses[i].push_back(address);
+            }
+            ok = ok && readInt(f, numRoutes);
+            for (uint32 j = 0; ok && j < numRoutes; j++)
+            {
+                ConfigCache::Route route;
+                uint32 metric;
+                ok = readInt(f, route.destination) && readInt(f, route.netmask) && readInt(f, route.gateway) && readInt(f, value) && readInt(f, metric);
+                route.interfaceId = value;
+                route.metric = metric;
+                cache.routes[i].push_back(route);
+            }
+        }
+    }
+    fclose(f);
+
+    if (!ok)
+    {
+        EV_INFO << "Configuration cache " << fileName << " is outdated, recomputing configuration\n";
+        cache.addresses.clear();
+        cache.routes.clear();
+        return false;
+    }
+    EV_INFO << "Using configuration cache " << fileName << endl;
+    return true;
+}
+
+void IPv4NetworkConfigurator::writeConfigCache(const char *fileName, uint64 hash, const ConfigCache& cache)
+{
+    // write into a temporary file in the same directory and rename it when complete,
+    // so that concurrent runs never read a partially written cache
+    std::ostringstream tmpFileNameStream;
+    tmpFileNameStream << fileName << "." << ev.getConfigEx()->getActiveRunNumber() << ".tmp";
+    std::string tmpFileName = tmpFileNameStream.str();
+
+    FILE *f = fopen(tmpFileName.c_str(), "wb");
+    if (!f)
+    {
+        EV << "Warning: cannot write configuration cache file '" << tmpFileName << "', the configuration is not cached\n";
+        return;
+    }
+
+    fwrite(CONFIG_CACHE_MAGIC, 1, 8, f);
+    writeInt(f, hash >> 32);
+    writeInt(f, hash & 0xFFFFFFFF);
+    writeInt(f, cache.routes.size());
+    for (int i = 0; i < (int)cache.routes.size(); i++)
+    {
+        const std::vector<ConfigCache::Address>& addresses = cache.addresses[i];
+        writeInt(f, addresses.size());
+        for (int j = 0; j < (int)addresses.size(); j++)
+        {
+            writeInt(f, addresses[j].interfaceId);
+            writeInt(f, addresses[j].address);
+            writeInt(f, addresses[j].netmask);
+        }
+        const std::vector<ConfigCache::Route>& routes = cache.routes[i];
+        writeInt(f, routes.size());
+        for (int j = 0; j < (int)routes.size(); j++)
+        {
+            writeInt(f, routes[j].destination);
+            writeInt(f, routes[j].netmask);
+            writeInt(f, routes[j].gateway);
+            writeInt(f, routes[j].interfaceId);
+            writeInt(f, routes[j].metric);
+        }
+    }
+    bool ok = !ferror(f);
+    ok = fclose(f) == 0 && ok;
+
+    // rename() does not replace an existing file on all platforms
+    if (ok && rename(tmpFileName.c_str(), fileName) != 0)
+        ok = remove(fileName) == 0 && rename(tmpFileName.c_str(), fileName) == 0;
+    if (!ok)
+    {
+        EV << "Warning: cannot write configuration cache file '" << fileName << "', the configuration is not cached\n";
+        remove(tmpFileName.c_str());
+    }
+}
+
+void IPv4NetworkConfigurator::collectAddresses(IPv4Topology& topology, ConfigCache& cache)
+{
+    for (int i = 0; i < topology.getNumNodes(); i++)
+    {
+        Node *node = (Node *)topology.getNode(i);
+        for (int j = 0; j < (int)node->interfaceInfos.size(); j++)
+        {
+            InterfaceInfo *interfaceInfo = node->interfaceInfos[j];
+            if (interfaceInfo->configure)
+            {
+                IPv4InterfaceData *interfaceData = interfaceInfo->interfaceEntry->ipv4Data();
+                ConfigCache::Address address;
+                address.interfaceId = interfaceInfo->interfaceEntry->getInterfaceId();
+                address.address = interfaceData->getIPAddress().getInt();
+                address.netmask = interfaceData->getNetmask().getInt();
+                cache.addresses[i].push_back(address);
+            }
+        }
+    }
+}
+
+void IPv4NetworkConfigurator::collectStaticRoutes(IPv4Topology& topology, const std::vector<std::set<IPv4Route *> >& manualRoutes, ConfigCache& cache)
+{
+    for (int i = 0; i < topology.getNumNodes(); i++)
+    {
+        IRoutingTable *routingTable = ((Node *)topology.getNode(i))->routingTable;
+        for (int j = 0; routingTable && j < routingTable->getNumRoutes(); j++)
+        {
+            IPv4Route *route = routingTable->getRoute(j);
+            if (manualRoutes[i].count(route) == 0)
+            {
+                ConfigCache::Route cachedRoute;
+                cachedRoute.destination = route->getDestination().getInt();
+                cachedRoute.netmask = route->getNetmask().getInt();
+                cachedRoute.gateway = route->getGateway().getInt();
+                cachedRoute.interfaceId = route->getInterface()->getInterfaceId();
+                cachedRoute.metric = route->getMetric();
+                cache.routes[i].push_back(cachedRoute);
+            }
+        }
+    }
+}
+
+void IPv4NetworkConfigurator::applyCachedAddresses(IPv4Topology& topology, const ConfigCache& cache)
+{
+    for (int i = 0; i < topology.getNumNodes(); i++)
+    {
+        Node *node = (Node *)topology.getNode(i);
+        const std::vector<ConfigCache::Address>& addresses = cache.addresses[i];
+        for (int j = 0; j < (int)addresses.size(); j++)
+        {
+            InterfaceEntry *interfaceEntry = node->interfaceTable ? node->interfaceTable->getInterfaceById(addresses[j].interfaceId) : NULL;
+            if (!interfaceEntry || !interfaceEntry->ipv4Data())
+                throw cRuntimeError("Configuration cache refers to nonexistent interface %d in %s", addresses[j].interfaceId, node->module->getFullPath().c_str());
+            interfaceEntry->ipv4Data()->setIPAddress(IPv4Address(addresses[j].address));
+            interfaceEntry->ipv4Data()->setNetmask(IPv4Address(addresses[j].netmask));
+        }
+    }
+}
+
+void IPv4NetworkConfigurator::applyCachedRoutes(IPv4Topology& topology, const ConfigCache& cache)
+{
+    for (int i = 0; i < topology.getNumNodes(); i++)
+    {
+        Node *node = (Node *)topology.getNode(i);
+        const std::vector<ConfigCache::Route>& routes = cache.routes[i];
+        for (int j = 0; j < (int)routes.size(); j++)
+        {
+            InterfaceEntry *interfaceEntry = node->interfaceTable ? node->interfaceTable->getInterfaceById(routes[j].interfaceId) : NULL;
+            if (!interfaceEntry || !node->routingTable)
+                throw cRuntimeError("Configuration cache refers to nonexistent interface %d in %s", routes[j].interfaceId, node->module->getFullPath().c_str());
+            IPv4Route *route = new IPv4Route();
+            route->setDestination(IPv4Address(routes[j].destination));
+            route->setNetmask(IPv4Address(routes[j].netmask));
+            route->setGateway(IPv4Address(routes[j].gateway));
+            route->setInterface(interfaceEntry);
+            route->setMetric(routes[j].metric);
+            route->setSource(IPv4Route::MANUAL);
+            node->routingTable->addRoute(route);
+        }
+    }
+}
+
 void IPv4NetworkConfigurator::dumpTopology(IPv4Topology& topology)
 {
     for (int i = 0; i < topology.getNumNodes(); i++)
@@ -1785,73 +2144,6 @@ int IPv4NetworkConfigurator::findRouteIndexWithSameColor(const std::vector<IPv4R
     return -1;
 }
 
-/**
- * Returns true if swapping two ADJACENT routes in the routing table does not change the table's meaning.
- */
-bool IPv4NetworkConfigurator::routesCanBeSwapped(RouteInfo *routeInfo1, RouteInfo *routeInfo2)
-{
-    if (routeInfo1->color == routeInfo2->color)
-        return true;  // these two routes send the packet in the same direction (same gw/iface), doesn't matter which one we use -> can be swapped
-    else {
-        // unrelated routes can also be swapped
-        uint32 netmask = routeInfo1->netmask & routeInfo2->netmask;
-        return (routeInfo1->destination & netmask) != (routeInfo2->destination & netmask);
-    }
-}
-
-/**
- * Returns true if the routes can be neighbors by repeatedly swapping routes
- * in the routing table without changing their meaning.
- */
-bool IPv4NetworkConfigurator::routesCanBeNeighbors(const std::vector<RouteInfo *>& routeInfos, int i, int j)
-{
-    int begin = std::min(i, j);
-    int end = std::max(i, j);
-    IPv4NetworkConfigurator::RouteInfo *beginRouteInfo = routeInfos.at(begin);
-    for (int index = begin + 1; index < end; index++)
-        if (!routesCanBeSwapped(beginRouteInfo, routeInfos.at(index)))
-            return false;
-    return true;
-}
-
-/**
- * Returns true if the original route is interrupted by any of the routes in
- * the routing table between begin and end.
- */
-bool IPv4NetworkConfigurator::interruptsOriginalRoute(const RoutingTableInfo& routingTableInfo, int begin, int end, RouteInfo *originalRouteInfo)
-{
-    IPv4NetworkConfigurator::RouteInfo *matchingRouteInfo = routingTableInfo.findBestMatchingRouteInfo(originalRouteInfo->destination, begin, end);
-    return matchingRouteInfo && matchingRouteInfo->color != originalRouteInfo->color;
-}
-
-/**
- * Returns true if any of the original routes is interrupted by any of the
- * routes in the routing table between begin and end.
- */
-bool IPv4NetworkConfigurator::interruptsAnyOriginalRoute(const RoutingTableInfo& routingTableInfo, int begin, int end, const std::vector<RouteInfo *>& originalRouteInfos)
-{
-    if (begin < end)
-        for (int i = 0; i < (int)originalRouteInfos.size(); i++)
-            if (interruptsOriginalRoute(routingTableInfo, begin, end, originalRouteInfos.at(i)))
-                return true;
-    return false;
-}
-
-/**
- * Returns true if any of the original routes attached to the routes in the
- * routing table below index are interrupted by the route at index.
- */
-bool IPv4NetworkConfigurator::interruptsSubsequentOriginalRoutes(const RoutingTableInfo& routingTableInfo, int index)
-{
-    for (int i = index + 1; i < (int)routingTableInfo.routeInfos.size(); i++)
-    {
-        IPv4NetworkConfigurator::RouteInfo *routeInfo = routingTableInfo.routeInfos.at(i);
-        if (interruptsAnyOriginalRoute(routingTableInfo, index, index + 1, routeInfo->originalRouteInfos))
-            return true;
-    }
-    return false;
-}
-
 /**
  * Asserts that all original routes are still routed the same way as by the original routing table.
  */
@@ -1868,167 +2160,106 @@ void IPv4NetworkConfigurator::checkOriginalRoutes(const RoutingTableInfo& routin
 }
 
 /**
- * Returns the longest shared address prefix and netmask by iterating through bits from left to right.
+ * Binary trie node used by optimizeRoutes(). Children are indices into the
+ * node vector, the root is at index 0.
  */
-void IPv4NetworkConfigurator::findLongestCommonDestinationPrefix(uint32 destination1, uint32 netmask1, uint32 destination2, uint32 netmask2, uint32& destinationOut, uint32& netmaskOut)
+struct RouteTrieNode
 {
-    netmaskOut = 0;
-    destinationOut = 0;
-    for (int bitIndex = 31; bitIndex >= 0; bitIndex--)
-    {
-        uint32 mask = 1 << bitIndex;
-        if ((destination1 & mask) == (destination2 & mask) &&
-            (netmask1 & mask) != 0 && (netmask2 & mask) != 0)
-        {
-            netmaskOut |= mask;
-            destinationOut |= destination1 & mask;
-        }
-        else
-            break;
-    }
-}
+    int children[2];          // -1 if missing
+    int color;                // color of the route with this prefix, -1 if none
+    std::vector<int> colors;  // sorted set of colors that may route this prefix, empty means any
+
+    RouteTrieNode() { children[0] = children[1] = -1; color = -1; }
+};
 
 /**
- * Adds all of the original routes to the matching optimized routes between begin and end.
+ * ORTC pass 1: every node inherits the color of its closest ancestor with
+ * a route, and nodes with a single child get the missing sibling, so that
+ * the trie becomes full. Leaves not covered by any route keep color -1.
  */
-void IPv4NetworkConfigurator::addOriginalRouteInfos(RoutingTableInfo& routingTableInfo, int begin, int end, const std::vector<RouteInfo *>& originalRouteInfos)
+static void pushDownColors(std::vector<RouteTrieNode>& trie, int index, int inheritedColor)
 {
-    for (int i = 0; i < (int)originalRouteInfos.size(); i++)
+    if (trie[index].color == -1)
+        trie[index].color = inheritedColor;
+    if (trie[index].children[0] == -1 && trie[index].children[1] == -1)
+        return;
+    for (int bit = 0; bit < 2; bit++)
     {
-        IPv4NetworkConfigurator::RouteInfo *originalRouteInfo = originalRouteInfos.at(i);
-        IPv4NetworkConfigurator::RouteInfo *matchingRouteInfo = routingTableInfo.findBestMatchingRouteInfo(originalRouteInfo->destination, begin, end);
-        ASSERT(matchingRouteInfo && matchingRouteInfo->color == originalRouteInfo->color);
-        matchingRouteInfo->originalRouteInfos.push_back(originalRouteInfo);
+        if (trie[index].children[bit] == -1)
+        {
+            trie[index].children[bit] = trie.size();
+            trie.push_back(RouteTrieNode());
+        }
     }
+    int color = trie[index].color;
+    pushDownColors(trie, trie[index].children[0], color);
+    pushDownColors(trie, trie[index].children[1], color);
 }
 
 /**
- * Try to merge two routes that have the same color and could be neighbours in table
- * without changing the table's meaning. There are two merge opportunities:
- * (1) one route's network contains the other one (then the second can be dropped),
- * and (2) use a shorter common prefix that covers both (this is only possible
- * if this doesn't interfere with existing routes in the table).
- * Returns true if the two routes have been merged, otherwise returns false.
+ * ORTC pass 2: computes the set of colors each node could be routed with,
+ * bottom-up. The set of a parent is the intersection of its children's sets
+ * if that is not empty, otherwise their union. Addresses that no original
+ * route covers accept any color.
  */
-bool IPv4NetworkConfigurator::tryToMergeTwoRoutes(RoutingTableInfo& routingTableInfo, int i, int j, RouteInfo *routeInfoI, RouteInfo *routeInfoJ)
-{
-    // determine longest shared address prefix and netmask by iterating through bits from left to right
-    uint32 netmask;
-    uint32 destination;
-    findLongestCommonDestinationPrefix(routeInfoI->destination, routeInfoI->netmask, routeInfoJ->destination, routeInfoJ->netmask, destination, netmask);
-
-    // create the merged route
-    RouteInfo *mergedRouteInfo = new RouteInfo(routeInfoI->color, destination, netmask);
-    routeInfoI->enabled = false;
-    routeInfoJ->enabled = false;
-    int m = routingTableInfo.addRouteInfo(mergedRouteInfo);
-    ASSERT(m > i && m > j);
-
-    // check if all the original routes are still routed the same way by the optimized routing table.
-    // check optimization: instead of checking all the original routes, check only those which can go wrong due to the merge.
-    // (assuming the previous configuration was correct)
-    //  - the original routes on I and J are going to be routed by M after the merge, so check if the routes in between don't interrupt them
-    //  - the original routes following M can be accidentally overridden by M (being larger than the sum of I and J), so verify that M does not interrupt them
-    // note that the condition is not symmetric because I follows J so it requires fewer checks and we do use that.
-    if (!interruptsAnyOriginalRoute(routingTableInfo, j + 1, i, routeInfoJ->originalRouteInfos) && // check that original routes on J are not interrupted between J and I
-        !interruptsAnyOriginalRoute(routingTableInfo, i + 1, m, routeInfoJ->originalRouteInfos) && // check that original routes on J are not interrupted between I and M
-        !interruptsAnyOriginalRoute(routingTableInfo, i + 1, m, routeInfoI->originalRouteInfos) && // check that original routes on I are not interrupted between I and M
-        !interruptsSubsequentOriginalRoutes(routingTableInfo, m)) // check that the original routes after M are not interrupted by M
-    {
-        // now we know that the merge does not conflict with any route in the routing table.
-        // the next thing to do is to maintain the original routes attached to the optimized ones.
-        // move original routes from the to be deleted I route to the capturing routes.
-        addOriginalRouteInfos(routingTableInfo, i + 1, m + 1, routeInfoI->originalRouteInfos);
-
-        // move original routes from the to be deleted J route to the capturing routes.
-        addOriginalRouteInfos(routingTableInfo, j + 1, m + 1, routeInfoJ->originalRouteInfos);
-
-        // move original routes from the routes following the merged one if necessary.
-        for (int k = m + 1; k < (int)routingTableInfo.routeInfos.size(); k++)
-        {
-            IPv4NetworkConfigurator::RouteInfo *followingRouteInfo = routingTableInfo.routeInfos.at(k);
-            for (int l = 0; l < (int)followingRouteInfo->originalRouteInfos.size(); l++)
-            {
-                IPv4NetworkConfigurator::RouteInfo *originalRouteInfo = followingRouteInfo->originalRouteInfos.at(l);
-                if (!((originalRouteInfo->destination ^ mergedRouteInfo->destination) & mergedRouteInfo->netmask))
-                {
-                    followingRouteInfo->originalRouteInfos.erase(followingRouteInfo->originalRouteInfos.begin() + l);
-                    ASSERT(mergedRouteInfo->color == originalRouteInfo->color);
-                    mergedRouteInfo->originalRouteInfos.push_back(originalRouteInfo);
-                    l--;
-                }
-            }
-        }
-        routingTableInfo.removeRouteInfo(routeInfoI);
-        routingTableInfo.removeRouteInfo(routeInfoJ);
-#ifndef NDEBUG
-        //checkOriginalRoutes(routingTableInfo, originalRouteInfos);
-#endif
-        delete routeInfoI;
-        delete routeInfoJ;
-        return true;
+static void computeColorSets(std::vector<RouteTrieNode>& trie, int index)
+{
+    RouteTrieNode& node = trie[index];
+    if (node.children[0] == -1)
+    {
+        if (node.color != -1)
+            node.colors.push_back(node.color);
+        return;
     }
+    computeColorSets(trie, node.children[0]);
+    computeColorSets(trie, node.children[1]);
+    const std::vector<int>& colors0 = trie[node.children[0]].colors;
+    const std::vector<int>& colors1 = trie[node.children[1]].colors;
+    if (colors0.empty())
+        node.colors = colors1;
+    else if (colors1.empty())
+        node.colors = colors0;
     else
     {
-        // merge failed; restore original state
-        routeInfoI->enabled = true;
-        routeInfoJ->enabled = true;
-        routingTableInfo.removeRouteInfo(mergedRouteInfo);
-        delete mergedRouteInfo;
-        return false;
+        std::set_intersection(colors0.begin(), colors0.end(), colors1.begin(), colors1.end(), std::back_inserter(node.colors));
+        if (node.colors.empty())
+            std::set_union(colors0.begin(), colors0.end(), colors1.begin(), colors1.end(), std::back_inserter(node.colors));
     }
 }
 
 /**
- * Iteratively checks if any two routes can be aggressively merged without changing the meaning of all original routes.
- * The merged route will have the longest shared address prefix and netmask with the two merged routes.
- * This optimization might change the meaning of the routing table in that it will route packets that it did not route before.
- * Nevertheless, any packet routed by the original routing table will still be routed the same way by the optimized routing table.
- * Returns true if two routes has been merged, otherwise returns false.
+ * ORTC pass 3: walks top-down and adds a route wherever the color inherited
+ * from the closest selected ancestor route is not acceptable for the node.
  */
-bool IPv4NetworkConfigurator::tryToMergeAnyTwoRoutes(RoutingTableInfo& routingTableInfo)
+static void selectRoutes(const std::vector<RouteTrieNode>& trie, int index, uint32 prefix, int length, int inheritedColor, std::vector<IPv4NetworkConfigurator::RouteInfo *>& routeInfos)
 {
-    for (int i = 0; i < (int)routingTableInfo.routeInfos.size(); i++)
+    const RouteTrieNode& node = trie[index];
+    if (!node.colors.empty() && !std::binary_search(node.colors.begin(), node.colors.end(), inheritedColor))
     {
-        IPv4NetworkConfigurator::RouteInfo *routeInfoI = routingTableInfo.routeInfos.at(i);
-
-        // iterate backward so that we try to merge routes having longer netmasks first.
-        // this results in smaller changes and allows more symmetric optimization.
-        for (int j = i - 1; j >= 0; j--)
-        {
-            IPv4NetworkConfigurator::RouteInfo *routeInfoJ = routingTableInfo.routeInfos.at(j);
-
-            // we can only merge neighbor routes having the same color
-            if (routeInfoI->color == routeInfoJ->color && routesCanBeNeighbors(routingTableInfo.routeInfos, i, j))
-            {
-                // it is worth to actually try to merge them
-                if (tryToMergeTwoRoutes(routingTableInfo, i, j, routeInfoI, routeInfoJ))
-                    return true;
-            }
-        }
+        inheritedColor = node.colors.front();
+        uint32 netmask = length == 0 ? 0 : ~(uint32)0 << (32 - length);
+        routeInfos.push_back(new IPv4NetworkConfigurator::RouteInfo(inheritedColor, prefix, netmask));
     }
-    return false;
+    for (int bit = 0; bit < 2; bit++)
+        if (node.children[bit] != -1)
+            selectRoutes(trie, node.children[bit], prefix | ((uint32)bit << (31 - length)), length + 1, inheritedColor, routeInfos);
 }
 
 void IPv4NetworkConfigurator::optimizeRoutes(std::vector<IPv4Route *>& originalRoutes)
 {
-    // The basic idea: if two routes "do the same" (same output interface, gateway, etc) and
-    // match "similar" addresses, one can try to move them to be neighbors in the table and
-    // replace them with a single route which contains their longest common prefix as address
-    // prefix -- provided that this operation doesn't affect the meaning of the routing table
-    // for "existing" addresses. (We don't care about changing the routing for addresses that
-    // we know don't occur in our currently configured network.) We can repeatedly merge routes
-    // in this way until it's not possible any more. Of course, the result also depends on
-    // which pairs of routes we merge, and in which order.
+    // The routes are compressed with the Optimal Routing Table Constructor (ORTC) algorithm
+    // (R. Draves et al.: Constructing Optimal IP Routing Tables, INFOCOM 1999). It builds a binary
+    // trie of the prefixes, and computes the smallest set of prefixes that routes every address
+    // covered by the original routes the same way, in three passes over the trie. Addresses that
+    // no original route covers are treated as "don't care" (we know they don't occur in our
+    // currently configured network), so the result may route packets that the original table did not.
 
     // STEP 1.
-    // instead of working with IPv4 routes we transform them into the internal representation of the optimizer.
     // routes are classified based on their action (gateway, interface, type, source, metric, etc.) and a color is assigned to them.
-    RoutingTableInfo routingTableInfo;
+    // the route prefixes are inserted into a binary trie, the first route wins among routes with the same prefix.
     std::vector<IPv4Route *> colorToRoute;  // a mapping from color to route action (interface, gateway, metric, etc.)
     std::vector<RouteInfo *> originalRouteInfos; // a copy of the original routes in the optimizer's format
-
-    // build colorToRouteColor, originalRouteInfos and initial routeInfos in routingTableInfo
+    std::vector<RouteTrieNode> trie(1);
     for (int i = 0; i < (int)originalRoutes.size(); i++)
     {
         IPv4Route *originalRoute = originalRoutes.at(i);
@@ -2039,28 +2270,46 @@ void IPv4NetworkConfigurator::optimizeRoutes(std::vector<IPv4Route *>& originalR
             colorToRoute.push_back(originalRoute);
         }
 
-        // create original route and determine its color
-        RouteInfo *originalRouteInfo = new RouteInfo(color, originalRoute->getDestination().getInt(), originalRoute->getNetmask().getInt());
-        originalRouteInfos.push_back(originalRouteInfo);
+        uint32 destination = originalRoute->getDestination().getInt();
+        uint32 netmask = originalRoute->getNetmask().getInt();
+        if (netmask & (~netmask >> 1))
+        {
+            // the trie can only represent contiguous netmasks
+            EV_INFO << "Not optimizing routes because of non-contiguous netmask " << originalRoute->getNetmask() << endl;
+            for (int j = 0; j < (int)originalRouteInfos.size(); j++)
+                delete originalRouteInfos[j];
+            return;
+        }
+        originalRouteInfos.push_back(new RouteInfo(color, destination, netmask));
 
-        // create a copy of the original route that can be destructively optimized later
-        RouteInfo *optimizedRouteInfo = new RouteInfo(*originalRouteInfo);
-        optimizedRouteInfo->originalRouteInfos.push_back(originalRouteInfo);
-        routingTableInfo.addRouteInfo(optimizedRouteInfo);
+        int index = 0;
+        for (int length = 0; length < 32 && (netmask & (0x80000000u >> length)); length++)
+        {
+            int bit = (destination >> (31 - length)) & 1;
+            if (trie[index].children[bit] == -1)
+            {
+                trie[index].children[bit] = trie.size();
+                trie.push_back(RouteTrieNode());
+            }
+            index = trie[index].children[bit];
+        }
+        if (trie[index].color == -1)
+            trie[index].color = color;
     }
 
-#ifndef NDEBUG
-    checkOriginalRoutes(routingTableInfo, originalRouteInfos);
-#endif
-
     // STEP 2.
-    // from now on we are only working with the internal data structures called RouteInfo and RoutingTableInfo.
-    // the main optimizer loop runs until it cannot merge any two routes.
-    while (tryToMergeAnyTwoRoutes(routingTableInfo));
+    // run the three passes of the algorithm, collecting the optimized routes
+    pushDownColors(trie, 0, -1);
+    computeColorSets(trie, 0);
+    RoutingTableInfo routingTableInfo;
+    selectRoutes(trie, 0, 0, 0, -1, routingTableInfo.routeInfos);
+    std::sort(routingTableInfo.routeInfos.begin(), routingTableInfo.routeInfos.end(), RoutingTableInfo::routeInfoLessThan);
 
 #ifndef NDEBUG
     checkOriginalRoutes(routingTableInfo, originalRouteInfos);
 #endif
+    for (int i = 0; i < (int)originalRouteInfos.size(); i++)
+        delete originalRouteInfos[i];
 
     // STEP 3.
     // convert the optimized routes to new optimized IPv4 routes based on the saved colors
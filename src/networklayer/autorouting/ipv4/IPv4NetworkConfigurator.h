@@ -137,12 +137,10 @@ class INET_API IPv4NetworkConfigurator : public cSimpleModule
         class RouteInfo {
             public:
                 int color;          // an index into an array representing the different route actions (gateway, interface, metric, etc.)
-                bool enabled;       // allows turning of routes without removing them from the list
                 uint32 destination; // originally copied from the IPv4Route
                 uint32 netmask;     // originally copied from the IPv4Route
-                std::vector<RouteInfo *> originalRouteInfos; // routes that are routed by this one from the unoptimized original routing table, we keep track of this to be able to skip merge candidates with less computation
 
-                RouteInfo(int color, uint32 destination, uint32 netmask) { this->color = color; this->enabled = true; this->destination = destination; this->netmask = netmask; }
+                RouteInfo(int color, uint32 destination, uint32 netmask) { this->color = color; this->destination = destination; this->netmask = netmask; }
         };
 
         /**
@@ -150,20 +148,12 @@ class INET_API IPv4NetworkConfigurator : public cSimpleModule
          */
         class RoutingTableInfo {
             public:
-                std::vector<RouteInfo *> routeInfos; // list of routes in the routing table
+                std::vector<RouteInfo *> routeInfos; // list of routes in the routing table, sorted by routeInfoLessThan
 
-                int addRouteInfo(RouteInfo *routeInfo) {
-                    std::vector<RouteInfo *>::iterator it = upper_bound(routeInfos.begin(), routeInfos.end(), routeInfo, routeInfoLessThan);
-                    int index = it - routeInfos.begin();
-                    routeInfos.insert(it, routeInfo);
-                    return index;
-                }
-                void removeRouteInfo(const RouteInfo *routeInfo) { routeInfos.erase(std::find(routeInfos.begin(), routeInfos.end(), routeInfo)); }
-                RouteInfo *findBestMatchingRouteInfo(const uint32 destination) const { return findBestMatchingRouteInfo(destination, 0, routeInfos.size()); }
-                RouteInfo *findBestMatchingRouteInfo(const uint32 destination, int begin, int end) const {
-                    for (int index = begin; index < end; index++) {
+                RouteInfo *findBestMatchingRouteInfo(const uint32 destination) const {
+                    for (int index = 0; index < (int)routeInfos.size(); index++) {
                         RouteInfo *routeInfo = routeInfos.at(index);
-                        if (routeInfo->enabled && !((destination ^ routeInfo->destination) & routeInfo->netmask))
+                        if (!((destination ^ routeInfo->destination) & routeInfo->netmask))
                             return const_cast<RouteInfo *>(routeInfo);
                     }
                     return NULL;
@@ -171,6 +161,28 @@ class INET_API IPv4NetworkConfigurator : public cSimpleModule
                 static bool routeInfoLessThan(const RouteInfo *a, const RouteInfo *b) { return a->netmask != b->netmask ? a->netmask > b->netmask : a->destination < b->destination; }
         };
 
+        /**
+         * Interface addresses and static routes of a network configuration,
+         * as stored in the configuration cache file. Indexed by topology node.
+         */
+        class ConfigCache {
+            public:
+                struct Address {
+                    int interfaceId;
+                    uint32 address;
+                    uint32 netmask;
+                };
+                struct Route {
+                    uint32 destination;
+                    uint32 netmask;
+                    uint32 gateway;
+                    int interfaceId;
+                    int metric;
+                };
+                std::vector<std::vector<Address> > addresses;
+                std::vector<std::vector<Route> > routes;
+        };
+
         class Matcher
         {
             private:
@@ -235,7 +247,8 @@ class INET_API IPv4NetworkConfigurator : public cSimpleModule
         virtual void addStaticRoutes(IPv4Topology& topology);
 
         /**
-         * Destructively optimizes the given IPv4 routes by merging some of them.
+         * Destructively optimizes the given IPv4 routes by replacing them with
+         * the smallest equivalent set of prefixes (ORTC algorithm, O(n*w)).
          * The resulting routes might be different in that they will route packets
          * that the original routes did not. Nevertheless the following invariant
          * holds: any packet routed by the original routes will still be routed
@@ -243,6 +256,25 @@ class INET_API IPv4NetworkConfigurator : public cSimpleModule
          */
         virtual void optimizeRoutes(std::vector<IPv4Route *> &routes);
 
+        /**
+         * Computes a hash of everything the configuration depends on: the
+         * extracted topology with its interfaces and link weights, the
+         * preconfigured interface addresses, the XML configuration, and the
+         * module parameters.
+         */
+        virtual uint64 computeConfigHash(cXMLElement *root, IPv4Topology& topology);
+
+        /**
+         * Reads the cache file. Returns false if the file does not exist or
+         * it was written for a different configuration (hash).
+         */
+        virtual bool readConfigCache(const char *fileName, uint64 hash, IPv4Topology& topology, ConfigCache& cache);
+        virtual void writeConfigCache(const char *fileName, uint64 hash, const ConfigCache& cache);
+        virtual void collectAddresses(IPv4Topology& topology, ConfigCache& cache);
+        virtual void collectStaticRoutes(IPv4Topology& topology, const std::vector<std::set<IPv4Route *> >& manualRoutes, ConfigCache& cache);
+        virtual void applyCachedAddresses(IPv4Topology& topology, const ConfigCache& cache);
+        virtual void applyCachedRoutes(IPv4Topology& topology, const ConfigCache& cache);
+
         virtual void dumpTopology(IPv4Topology& topology);
         virtual void dumpLinks(IPv4Topology& topology);
         virtual void dumpAddresses(IPv4Topology& topology);
@@ -279,16 +311,7 @@ class INET_API IPv4NetworkConfigurator : public cSimpleModule
         bool containsRoute(const std::vector<IPv4Route *>& routes, IPv4Route *route);
         bool routesHaveSameColor(IPv4Route *route1, IPv4Route *route2);
         int findRouteIndexWithSameColor(const std::vector<IPv4Route *>& routes, IPv4Route *route);
-        bool routesCanBeSwapped(RouteInfo *routeInfo1, RouteInfo *routeInfo2);
-        bool routesCanBeNeighbors(const std::vector<RouteInfo *>& routeInfos, int i, int j);
-        bool interruptsOriginalRoute(const RoutingTableInfo& routingTableInfo, int begin, int end, RouteInfo *originalRouteInfo);
-        bool interruptsAnyOriginalRoute(const RoutingTableInfo& routingTableInfo, int begin, int end, const std::vector<RouteInfo *>& originalRouteInfos);
-        bool interruptsSubsequentOriginalRoutes(const RoutingTableInfo& routingTableInfo, int index);
         void checkOriginalRoutes(const RoutingTableInfo& routingTableInfo, const std::vector<RouteInfo *>& originalRouteInfos);
-        void findLongestCommonDestinationPrefix(uint32 destination1, uint32 netmask1, uint32 destination2, uint32 netmask2, uint32& destinationOut, uint32& netmaskOut);
-        void addOriginalRouteInfos(RoutingTableInfo& routingTableInfo, int begin, int end, const std::vector<RouteInfo *>& originalRouteInfos);
-        bool tryToMergeTwoRoutes(RoutingTableInfo& routingTableInfo, int i, int j, RouteInfo *routeInfoI, RouteInfo *routeInfoJ);
-        bool tryToMergeAnyTwoRoutes(RoutingTableInfo& routingTableInfo);
 
 };
 
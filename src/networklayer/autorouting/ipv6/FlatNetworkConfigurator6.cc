@@ -31,14 +31,14 @@ Define_Module(FlatNetworkConfigurator6);
 
 void FlatNetworkConfigurator6::initialize(int stage)
 {
-    // FIXME refactor: make routers[] array? (std::vector<cTopology::Node*>)
+    // FIXME refactor: make routers[] array? (std::vector<Topology::Node*>)
     // FIXME: spare common beginning for all stages?
 
-    cTopology topo("topo");
+    Topology topo("topo");
 
     // extract topology
     topo.extractByProperty("node");
-    EV << "cTopology found " << topo.getNumNodes() << " nodes\n";
+    EV << "Topology found " << topo.getNumNodes() << " nodes\n";
 
     if (stage==2)
     {
@@ -64,12 +64,12 @@ void FlatNetworkConfigurator6::setDisplayString(int numIPNodes, int numNonIPNode
     getDisplayString().setTagArg("t", 0, buf);
 }
 
-bool FlatNetworkConfigurator6::isIPNode(cTopology::Node *node)
+bool FlatNetworkConfigurator6::isIPNode(Topology::Node *node)
 {
     return IPvXAddressResolver().findInterfaceTableOf(node->getModule()) != NULL;
 }
 
-void FlatNetworkConfigurator6::configureAdvPrefixes(cTopology& topo)
+void FlatNetworkConfigurator6::configureAdvPrefixes(Topology& topo)
 {
     // assign advertised prefixes to all router interfaces
     for (int i = 0; i < topo.getNumNodes(); i++)
@@ -125,12 +125,12 @@ void FlatNetworkConfigurator6::configureAdvPrefixes(cTopology& topo)
     }
 }
 
-void FlatNetworkConfigurator6::addOwnAdvPrefixRoutes(cTopology& topo)
+void FlatNetworkConfigurator6::addOwnAdvPrefixRoutes(Topology& topo)
 {
     // add globally routable prefixes to routing table
     for (int i = 0; i < topo.getNumNodes(); i++)
     {
-        cTopology::Node *node = topo.getNode(i);
+        Topology::Node *node = topo.getNode(i);
 
         // skip bus types
         if (!isIPNode(node))
@@ -160,14 +160,14 @@ void FlatNetworkConfigurator6::addOwnAdvPrefixRoutes(cTopology& topo)
     }
 }
 
-void FlatNetworkConfigurator6::addStaticRoutes(cTopology& topo)
+void FlatNetworkConfigurator6::addStaticRoutes(Topology& topo)
 {
     int numIPNodes = 0;
 
     // fill in routing tables
     for (int i = 0; i < topo.getNumNodes(); i++)
     {
-        cTopology::Node *destNode = topo.getNode(i);
+        Topology::Node *destNode = topo.getNode(i);
 
         // skip bus types
         if (!isIPNode(destNode))
@@ -212,7 +212,7 @@ void FlatNetworkConfigurator6::addStaticRoutes(cTopology& topo)
             if (!isIPNode(topo.getNode(j)))
                 continue;
 
-            cTopology::Node *atNode = topo.getNode(j);
+            Topology::Node *atNode = topo.getNode(j);
             if (atNode->getNumPaths() == 0)
                 continue;       // not connected
 
@@ -230,7 +230,7 @@ void FlatNetworkConfigurator6::addStaticRoutes(cTopology& topo)
             // determine next hop link address. That's a bit tricky because
             // the directly adjacent cTopo node might be a non-IP getNode(ethernet switch etc)
             // so we have to "seek through" them.
-            cTopology::Node *prevNode = atNode;
+            Topology::Node *prevNode = atNode;
             // if there's no ethernet switch between atNode and it's next hop
             // neighbour, we don't go into the following while() loop
             while (!isIPNode(prevNode->getPath(0)->getRemoteNode()))
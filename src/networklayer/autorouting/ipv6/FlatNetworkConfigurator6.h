@@ -22,6 +22,8 @@
 
 #include "INETDefs.h"
 
+#include "Topology.h"
+
 
 /**
  * Configures IPv6 addresses and routing tables for a "flat" network,
@@ -37,12 +39,12 @@ class INET_API FlatNetworkConfigurator6 : public cSimpleModule
     virtual void initialize(int stage);
     virtual void handleMessage(cMessage *msg);
 
-    virtual void configureAdvPrefixes(cTopology& topo);
-    virtual void addOwnAdvPrefixRoutes(cTopology& topo);
-    virtual void addStaticRoutes(cTopology& topo);
+    virtual void configureAdvPrefixes(Topology& topo);
+    virtual void addOwnAdvPrefixRoutes(Topology& topo);
+    virtual void addStaticRoutes(Topology& topo);
 
     virtual void setDisplayString(int numIPNodes, int numNonIPNodes);
-    virtual bool isIPNode(cTopology::Node *node);
+    virtual bool isIPNode(Topology::Node *node);
 };
 
 #endif
@@ -182,6 +182,21 @@ class INET_API IRoutingTable
      */
     virtual bool deleteRoute(IPv4Route *entry) = 0;
 
+    /**
+     * Starts a series of route changes, e.g. the installation of the routes
+     * computed by a proactive routing protocol. Until the matching
+     * endRouteUpdate(), route changes do not invalidate the routing cache
+     * nor refresh the display string one by one; this is done once at the
+     * end. Route lookups remain correct during the update. Calls may be nested.
+     * Route change notifications are still fired for every route.
+     */
+    virtual void beginRouteUpdate() = 0;
+
+    /**
+     * Ends a series of route changes started with beginRouteUpdate().
+     */
+    virtual void endRouteUpdate() = 0;
+
     /**
      * Returns the total number of multicast routes.
      */
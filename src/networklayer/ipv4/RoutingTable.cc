@@ -52,6 +52,7 @@ RoutingTable::RoutingTable()
 {
     ift = NULL;
     nb = NULL;
+    routeUpdateDepth = 0;
 }
 
 RoutingTable::~RoutingTable()
@@ -269,6 +270,14 @@ void RoutingTable::invalidateCache()
     localBroadcastAddresses.clear();
 }
 
+void RoutingTable::routesModified()
+{
+    if (routeUpdateDepth > 0)
+        return;
+    invalidateCache();
+    updateDisplayString();
+}
+
 void RoutingTable::printRoutingTable() const
 {
     EV << "-- Routing table --\n";
@@ -488,7 +497,8 @@ IPv4Route *RoutingTable::findBestMatchingRoute(const IPv4Address& dest) const
 {
     Enter_Method("findBestMatchingRoute(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3)); // note: str().c_str() too slow here
 
-    RoutingCache::iterator it = routingCache.find(dest);
+    // the cache is not maintained during a route update
+    RoutingCache::iterator it = routeUpdateDepth > 0 ? routingCache.end() : routingCache.find(dest);
     if (it != routingCache.end())
     {
         if (it->second==NULL || it->second->isValid())
@@ -511,7 +521,8 @@ IPv4Route *RoutingTable::findBestMatchingRoute(const IPv4Address& dest) const
         }
     }
 
-    routingCache[dest] = bestRoute;
+    if (routeUpdateDepth == 0)
+        routingCache[dest] = bestRoute;
     return bestRoute;
 }
 
@@ -623,8 +634,7 @@ void RoutingTable::addRoute(IPv4Route *entry)
 
     internalAddRoute(entry);
 
-    invalidateCache();
-    updateDisplayString();
+    routesModified();
 
     nb->fireChangeNotification(NF_IPv4_ROUTE_ADDED, entry);
 }
@@ -648,8 +658,7 @@ IPv4Route *RoutingTable::removeRoute(IPv4Route *entry)
 
     if (entry != NULL)
     {
-        invalidateCache();
-        updateDisplayString();
+        routesModified();
         ASSERT(entry->getRoutingTable() == this); // still filled in, for the listeners' benefit
         nb->fireChangeNotification(NF_IPv4_ROUTE_DELETED, entry);
         entry->setRoutingTable(NULL);
@@ -665,8 +674,7 @@ bool RoutingTable::deleteRoute(IPv4Route *entry)
 
     if (entry != NULL)
     {
-        invalidateCache();
-        updateDisplayString();
+        routesModified();
         ASSERT(entry->getRoutingTable() == this); // still filled in, for the listeners' benefit
         nb->fireChangeNotification(NF_IPv4_ROUTE_DELETED, entry);
         delete entry;
@@ -674,6 +682,26 @@ bool RoutingTable::deleteRoute(IPv4Route *entry)
     return entry != NULL;
 }
 
+void RoutingTable::beginRouteUpdate()
+{
+    Enter_Method_Silent();
+
+    if (routeUpdateDepth++ == 0)
+        routingCache.clear();
+}
+
+void RoutingTable::endRouteUpdate()
+{
+    Enter_Method_Silent();
+
+    ASSERT(routeUpdateDepth > 0);
+    if (--routeUpdateDepth == 0)
+    {
+        invalidateCache();
+        updateDisplayString();
+    }
+}
+
 bool RoutingTable::multicastRouteLessThan(const IPv4MulticastRoute *a, const IPv4MulticastRoute *b)
 {
     // We want routes with longer
@@ -796,8 +824,7 @@ void RoutingTable::routeChanged(IPv4Route *entry, int fieldCode)
         ASSERT(entry != NULL);  // failure means inconsistency: route was not found in this routing table
         internalAddRoute(entry);
 
-        invalidateCache();
-        updateDisplayString();
+        routesModified();
     }
     nb->fireChangeNotification(NF_IPv4_ROUTE_CHANGED, entry); // TODO include fieldCode in the notification
 }
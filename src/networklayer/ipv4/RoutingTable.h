@@ -98,6 +98,9 @@ class INET_API RoutingTable: public cSimpleModule, public IRoutingTable, protect
     typedef std::map<IPv4Address, IPv4Route *> RoutingCache;
     mutable RoutingCache routingCache;
 
+    // nesting depth of beginRouteUpdate() calls; the routing cache is not used while nonzero
+    int routeUpdateDepth;
+
     // local addresses cache (to speed up isLocalAddress())
     typedef std::set<IPv4Address> AddressSet;
     mutable AddressSet localAddresses;
@@ -123,6 +126,10 @@ class INET_API RoutingTable: public cSimpleModule, public IRoutingTable, protect
     // invalidates routing cache and local addresses cache
     virtual void invalidateCache();
 
+    // invalidates caches and updates the display string after a route change,
+    // unless it is deferred to endRouteUpdate()
+    void routesModified();
+
     // helper for sorting routing table, used by addRoute()
     static bool routeLessThan(const IPv4Route *a, const IPv4Route *b);
 
@@ -300,6 +307,16 @@ class INET_API RoutingTable: public cSimpleModule, public IRoutingTable, protect
      */
     virtual bool deleteRoute(IPv4Route *entry);
 
+    /**
+     * Starts a series of route changes; see IRoutingTable::beginRouteUpdate().
+     */
+    virtual void beginRouteUpdate();
+
+    /**
+     * Ends a series of route changes started with beginRouteUpdate().
+     */
+    virtual void endRouteUpdate();
+
     /**
      * Returns the total number of multicast routes.
      */
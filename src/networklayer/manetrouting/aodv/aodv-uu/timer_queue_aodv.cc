@@ -68,11 +68,9 @@ void NS_CLASS timer_timeout(const simtime_t &now)
 
     while (!aodvTimerMap.empty())
     {
-        if (aodvTimerMap.begin()->first > now)
+        if (aodvTimerMap.getFirstExpiry() > now)
             return;
-        struct timer *t = aodvTimerMap.begin()->second;
-        aodvTimerMap.erase(aodvTimerMap.begin());
-        t->used = 0;
+        struct timer *t = aodvTimerMap.popFirst();
         /* Execute handler function for expired timer... */
         if (t->handler)
         {
@@ -96,12 +94,8 @@ NS_STATIC void NS_CLASS timer_add(struct timer *t)
         exit(-1);
     }
 
-    /* Make sure we remove unexpired timers before adding a new timeout... */
-    if (t->used)
-        timer_remove(t);
-
-    t->used = 1;
-    aodvTimerMap.insert(std::make_pair(t->timeout,t));
+    /* Unexpired timers are moved to the new timeout by the queue */
+    aodvTimerMap.insert(t->timeout, t);
     return;
 }
 
@@ -110,16 +104,7 @@ int NS_CLASS timer_remove(struct timer *t)
     if (!t)
         return -1;
 
-    t->used = 0;
-    for (AodvTimerMap::iterator it = aodvTimerMap.begin();it != aodvTimerMap.end();it++)
-    {
-        if (it->second == t)
-        {
-            aodvTimerMap.erase(it);
-            return 1;
-        }
-    }
-    return 0;
+    return aodvTimerMap.remove(t) ? 1 : 0;
 }
 
 
@@ -160,7 +145,7 @@ simtime_t NS_CLASS timer_age_queue()
     timer_timeout(now);
     if (aodvTimerMap.empty())
         return remaining;
-    remaining =  aodvTimerMap.begin()->first - now;
+    remaining =  aodvTimerMap.getFirstExpiry() - now;
     return remaining;
 }
 #else
@@ -44,6 +44,7 @@ struct timer
     simtime_t timeout;
     timeout_func_t handler;
     void *data;
+    ManetTimerQueue<struct timer>::iterator queuePos;
 };
 #else
 struct timer
@@ -721,7 +721,7 @@ void NS_CLASS scheduleNextEvent()
 
     if (!aodvTimerMap.empty())
     {
-        timer = aodvTimerMap.begin()->first;
+        timer = aodvTimerMap.getFirstExpiry();
         if (sendMessageEvent->isScheduled())
         {
             if (timer < sendMessageEvent->getArrivalTime())
@@ -135,7 +135,7 @@ class AODVUU : public ManetRoutingBase
         return false;
     }
     // cMessage  messageEvent;
-    typedef std::multimap<simtime_t, struct timer*> AodvTimerMap;
+    typedef ManetTimerQueue<struct timer> AodvTimerMap;
     AodvTimerMap aodvTimerMap;
     typedef std::map<ManetAddress, struct rt_table*> AodvRtTableMap;
     AodvRtTableMap aodvRtTableMap;
@@ -81,13 +81,23 @@ class ManetAddress
      */
     short int compare(const ManetAddress& other) const;
 
-    /// Compare operators
-    bool operator ==(const ManetAddress& other) const { return addrType==other.addrType && hi==other.hi && lo==other.lo; }
+    /**
+     * Compare operators. They are inline because ManetAddress is the key of
+     * most MANET routing tables. IPv4 and MAC addresses are stored in hi
+     * with lo==0, so hi is tested first: it decides nearly every comparison.
+     * The ordering is the same as that of compare().
+     */
+    bool operator ==(const ManetAddress& other) const { return hi==other.hi && lo==other.lo && addrType==other.addrType; }
     bool operator !=(const ManetAddress& other) const { return !operator==(other); }
-    bool operator <(const ManetAddress& other) const { return compare(other) < 0; }
-    bool operator <=(const ManetAddress& other) const { return compare(other) <= 0; }
-    bool operator >(const ManetAddress& other) const { return compare(other) > 0; }
-    bool operator >=(const ManetAddress& other) const { return compare(other) >= 0; }
+    bool operator <(const ManetAddress& other) const
+    {
+        if (addrType != other.addrType)
+            return addrType < other.addrType;
+        return hi < other.hi || (hi == other.hi && lo < other.lo);
+    }
+    bool operator <=(const ManetAddress& other) const { return !other.operator<(*this); }
+    bool operator >(const ManetAddress& other) const { return other.operator<(*this); }
+    bool operator >=(const ManetAddress& other) const { return !operator<(other); }
 
     /**
      * Returns true if this is the broadcast address.
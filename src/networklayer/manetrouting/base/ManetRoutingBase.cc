@@ -915,6 +915,7 @@ void ManetRoutingBase::omnet_clean_rte()
     if (mac_layer_)
         return;
     // clean the route table wlan interface entry
+    inet_rt->beginRouteUpdate();
     for (int i=inet_rt->getNumRoutes()-1; i>=0; i--)
     {
         entry = inet_rt->getRoute(i);
@@ -923,6 +924,19 @@ void ManetRoutingBase::omnet_clean_rte()
             inet_rt->deleteRoute(entry);
         }
     }
+    inet_rt->endRouteUpdate();
+}
+
+void ManetRoutingBase::beginRouteUpdate()
+{
+    if (!mac_layer_ && inet_rt)
+        inet_rt->beginRouteUpdate();
+}
+
+void ManetRoutingBase::endRouteUpdate()
+{
+    if (!mac_layer_ && inet_rt)
+        inet_rt->endRouteUpdate();
 }
 
 //
@@ -33,6 +33,7 @@
 #include "IInterfaceTable.h"
 #include "IPvXAddress.h"
 #include "ManetAddress.h"
+#include "ManetTimerQueue.h"
 #include "NotifierConsts.h"
 #include "ICMP.h"
 
@@ -187,6 +188,14 @@ class INET_API ManetRoutingBase : public cSimpleModule, public INotifiable, prot
     /// Erase all entries for wlan* interfaces in the routing table
     virtual void omnet_clean_rte();
 
+    /**
+     * Bracket a series of routing table changes, e.g. a route recomputation,
+     * so that the IPv4 routing table invalidates its caches only once.
+     * See IRoutingTable::beginRouteUpdate().
+     */
+    virtual void beginRouteUpdate();
+    virtual void endRouteUpdate();
+
     /**
      *  @name Cross layer routines
      */
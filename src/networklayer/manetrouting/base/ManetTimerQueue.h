@@ -0,0 +1,94 @@
+//
+// This library is free software, you can redistribute it
+// and/or modify
+// it under  the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation;
+// either version 2 of the License, or any later version.
+// The library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU Lesser General Public License for more details.
+//
+
+#ifndef __INET_MANETTIMERQUEUE_H
+#define __INET_MANETTIMERQUEUE_H
+
+#include <map>
+
+#include "INETDefs.h"
+
+/**
+ * Deadline-ordered queue of protocol timers, shared by the MANET routing
+ * protocols that multiplex all their timers onto one self-message
+ * (AODV-UU, DYMO-UM, OLSR).
+ *
+ * The queue is intrusive: the timer type T must provide two data members,
+ * <tt>used</tt> (nonzero while the timer is queued, like the flag of the
+ * AODV-UU and DYMO-UM timer structs) and <tt>queuePos</tt> (an iterator
+ * maintained by the queue). This makes remove() O(1) instead of a scan
+ * over all pending timers; insert() is O(log n). Timers with equal
+ * deadlines expire in insertion order.
+ *
+ * The owner module keeps a single self-message scheduled at
+ * getFirstExpiry(), and calls popFirst() from handleMessage() while the
+ * first deadline is not in the future.
+ */
+template <class T>
+class ManetTimerQueue
+{
+  public:
+    typedef std::multimap<simtime_t, T *> Map;
+    typedef typename Map::iterator iterator;
+
+  protected:
+    Map timers;
+
+  public:
+    /**
+     * Queues the timer to expire at the given time. A timer that is
+     * already queued is moved to the new deadline.
+     */
+    void insert(const simtime_t& expiry, T *timer)
+    {
+        if (timer->used)
+            remove(timer);
+        timer->queuePos = timers.insert(std::make_pair(expiry, timer));
+        timer->used = 1;
+    }
+
+    /**
+     * Removes the timer from the queue. Returns false if it was not queued.
+     */
+    bool remove(T *timer)
+    {
+        if (!timer->used)
+            return false;
+        timer->used = 0;
+        timers.erase(timer->queuePos);
+        return true;
+    }
+
+    /**
+     * Removes and returns the timer with the earliest deadline.
+     * The queue must not be empty.
+     */
+    T *popFirst()
+    {
+        iterator it = timers.begin();
+        T *timer = it->second;
+        timers.erase(it);
+        timer->used = 0;
+        return timer;
+    }
+
+    /** Returns the timer with the earliest deadline; the queue must not be empty. */
+    T *getFirst() const { return timers.begin()->second; }
+
+    /** Returns the earliest deadline; the queue must not be empty. */
+    simtime_t getFirstExpiry() const { return timers.begin()->first; }
+
+    bool empty() const { return timers.empty(); }
+    size_t size() const { return timers.size(); }
+};
+
+#endif
@@ -322,7 +322,9 @@ void Batman::sendPackets(const simtime_t &curr_time)
     if (curr_time - debug_timeout > 1) {
 
         debug_timeout = curr_time;
+        beginRouteUpdate();
         purge_orig( curr_time );
+        endRouteUpdate();
         //check_inactive_interfaces();
         if ( ( routing_class != 0 ) && ( curr_gateway == NULL ) )
             choose_gw();
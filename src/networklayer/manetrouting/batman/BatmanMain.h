@@ -119,12 +119,14 @@ class Batman : public ManetRoutingBase
     virtual void add_default_route(){}
 
     // Bits methods
-    virtual void bit_init(std::vector<TYPE_OF_WORD> &);
-    virtual uint8_t get_bit_status(std::vector<TYPE_OF_WORD> &seq_bits, uint16_t last_seqno, uint16_t curr_seqno );
-    virtual void bit_mark(std::vector<TYPE_OF_WORD>  &seq_bits, int32_t);
-    virtual void bit_shift(std::vector<TYPE_OF_WORD> &seq_bits, int32_t);
-    virtual char bit_get_packet(std::vector<TYPE_OF_WORD> &seq_bits, int16_t seq_num_diff, int8_t set_mark );
-    virtual int bit_packet_count( std::vector<TYPE_OF_WORD> &seq_bits );
+    // the sliding window functions work on num_words words starting at seq_bits,
+    // so that the per-interface windows in OrigNode::bcast_own are updated in place
+    virtual void bit_init(TYPE_OF_WORD *seq_bits);
+    virtual uint8_t get_bit_status(const TYPE_OF_WORD *seq_bits, uint16_t last_seqno, uint16_t curr_seqno );
+    virtual void bit_mark(TYPE_OF_WORD *seq_bits, int32_t);
+    virtual void bit_shift(TYPE_OF_WORD *seq_bits, int32_t);
+    virtual char bit_get_packet(TYPE_OF_WORD *seq_bits, int16_t seq_num_diff, int8_t set_mark );
+    virtual int bit_packet_count(const TYPE_OF_WORD *seq_bits );
     virtual uint8_t bit_count( int32_t to_count );
 
     virtual bool is_aborted(){return false;}
@@ -653,17 +653,17 @@ uint8_t Batman::count_real_packets(BatmanPacket *in, const ManetAddress &neigh,
         tmp_neigh_node = orig_node->neigh_list[list_pos];
 
         if (!is_duplicate)
-            is_duplicate = get_bit_status(tmp_neigh_node->real_bits, orig_node->last_real_seqno, in->getSeqNumber());
+            is_duplicate = get_bit_status(&tmp_neigh_node->real_bits[0], orig_node->last_real_seqno, in->getSeqNumber());
 
         if ((tmp_neigh_node->addr == neigh) && (tmp_neigh_node->if_incoming == if_incoming)) {
-            bit_get_packet(tmp_neigh_node->real_bits, in->getSeqNumber() - orig_node->last_real_seqno, 1);
+            bit_get_packet(&tmp_neigh_node->real_bits[0], in->getSeqNumber() - orig_node->last_real_seqno, 1);
             /*debug_output(3, "count_real_packets (yes): neigh = %s, is_new = %s, seq = %i, last seq = %i\n", neigh_str, (is_new_seqno ? "YES" : "NO"), in->seqno, orig_node->last_real_seqno);*/
         } else {
-            bit_get_packet(tmp_neigh_node->real_bits, in->getSeqNumber() - orig_node->last_real_seqno, 0);
+            bit_get_packet(&tmp_neigh_node->real_bits[0], in->getSeqNumber() - orig_node->last_real_seqno, 0);
             /*debug_output(3, "count_real_packets (no): neigh = %s, is_new = %s, seq = %i, last seq = %i\n", neigh_str, (is_new_seqno ? "YES" : "NO"), in->seqno, orig_node->last_real_seqno);*/
         }
 
-        tmp_neigh_node->real_packet_count = bit_packet_count(tmp_neigh_node->real_bits);
+        tmp_neigh_node->real_packet_count = bit_packet_count(&tmp_neigh_node->real_bits[0]);
     }
 
     if (!is_duplicate) {
@@ -840,15 +840,10 @@ void Batman::parseIncomingPacket(ManetAddress neigh, BatmanIf *if_incoming, Batm
                 if ((has_directlink_flag) && (sameIf) && (bat_packet->getSeqNumber() - if_incoming->seqno + 2 == 0)) {
                     debug_output(4) << "count own bcast (is_my_orig): old = " << (unsigned)(orig_neigh_node->bcast_own_sum[if_incoming->if_num]) << endl;
 
-                    std::vector<TYPE_OF_WORD> vectorAux;
-                    for (unsigned int i=0; i<num_words; i++)
-                        vectorAux.push_back(orig_neigh_node->bcast_own[(if_incoming->if_num * num_words)+i]);
-                    bit_mark(vectorAux, 0);
+                    TYPE_OF_WORD *bcast_own = &orig_neigh_node->bcast_own[if_incoming->if_num * num_words];
+                    bit_mark(bcast_own, 0);
 
-                    orig_neigh_node->bcast_own_sum[if_incoming->if_num] = bit_packet_count(vectorAux);
-
-                    for (unsigned int i=0; i<num_words; i++)
-                        orig_neigh_node->bcast_own[(if_incoming->if_num * num_words)+i] = vectorAux[i];
+                    orig_neigh_node->bcast_own_sum[if_incoming->if_num] = bit_packet_count(bcast_own);
 
                     debug_output(4) << "new = " << (unsigned)(orig_neigh_node->bcast_own_sum[if_incoming->if_num]) << endl;
                 }
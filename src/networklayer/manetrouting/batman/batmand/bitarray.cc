@@ -24,7 +24,7 @@
 
 
 /* clear the bits */
-void Batman::bit_init(std::vector<TYPE_OF_WORD> &seq_bits) {
+void Batman::bit_init(TYPE_OF_WORD *seq_bits) {
     int i;
 
     for (i = 0; i < (int)num_words; i++)
@@ -32,7 +32,7 @@ void Batman::bit_init(std::vector<TYPE_OF_WORD> &seq_bits) {
 }
 
 /* returns true if corresponding bit in given seq_bits indicates so and curr_seqno is within range of last_seqno */
-uint8_t Batman::get_bit_status(std::vector<TYPE_OF_WORD> &seq_bits, uint16_t last_seqno, uint16_t curr_seqno) {
+uint8_t Batman::get_bit_status(const TYPE_OF_WORD *seq_bits, uint16_t last_seqno, uint16_t curr_seqno) {
     int16_t diff, word_offset, word_num;
 
     diff = last_seqno- curr_seqno;
@@ -50,7 +50,7 @@ uint8_t Batman::get_bit_status(std::vector<TYPE_OF_WORD> &seq_bits, uint16_t las
 }
 
 /* turn corresponding bit on, so we can remember that we got the packet */
-void Batman::bit_mark(std::vector<TYPE_OF_WORD> &seq_bits, int32_t n) {
+void Batman::bit_mark(TYPE_OF_WORD *seq_bits, int32_t n) {
     int32_t word_offset, word_num;
     if (n<0 || n >= local_win_size) {            /* if too old, just drop it */
 /*         printf("got old packet, dropping\n");*/
@@ -66,7 +66,7 @@ void Batman::bit_mark(std::vector<TYPE_OF_WORD> &seq_bits, int32_t n) {
 }
 
 /* shift the packet array p by n places. */
-void Batman::bit_shift(std::vector<TYPE_OF_WORD> &seq_bits, int32_t n) {
+void Batman::bit_shift(TYPE_OF_WORD *seq_bits, int32_t n) {
     int32_t word_offset, word_num;
     int32_t i;
 
@@ -111,7 +111,7 @@ void Batman::bit_shift(std::vector<TYPE_OF_WORD> &seq_bits, int32_t n) {
 
 
 /* receive and process one packet, returns 1 if received seq_num is considered new, 0 if old  */
-char Batman::bit_get_packet(std::vector<TYPE_OF_WORD> &seq_bits, int16_t seq_num_diff, int8_t set_mark)
+char Batman::bit_get_packet(TYPE_OF_WORD *seq_bits, int16_t seq_num_diff, int8_t set_mark)
 {
     int i;
 
@@ -147,7 +147,7 @@ char Batman::bit_get_packet(std::vector<TYPE_OF_WORD> &seq_bits, int16_t seq_num
 }
 
 /* count the hamming weight, how many good packets did we receive? just count the 1's ... */
-int Batman::bit_packet_count(std::vector<TYPE_OF_WORD> &seq_bits)
+int Batman::bit_packet_count(const TYPE_OF_WORD *seq_bits)
 {
     int i, hamming = 0;
     TYPE_OF_WORD word;
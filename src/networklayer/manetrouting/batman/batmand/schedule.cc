@@ -82,16 +82,9 @@ void Batman::schedule_own_packet(BatmanIf *batman_if)
         orig_node = it->second;
 
         debug_output(4) << "count own bcast (schedule_own_packet): old = " << orig_node->bcast_own_sum[batman_if->if_num] << ", ";
-        std::vector<TYPE_OF_WORD>vectorAux;
-        for (unsigned int i=0; i<num_words; i++) {
-            vectorAux.push_back(orig_node->bcast_own[(batman_if->if_num * num_words)+i]);
-        }
-        bit_get_packet(vectorAux, 1, 0);
-        orig_node->bcast_own_sum[batman_if->if_num] = bit_packet_count(vectorAux);
-        for (unsigned int i=0; i<num_words; i++) {
-            orig_node->bcast_own[(batman_if->if_num * num_words)+i] = vectorAux[i];
-        }
-        vectorAux.clear();
+        TYPE_OF_WORD *bcast_own = &orig_node->bcast_own[batman_if->if_num * num_words];
+        bit_get_packet(bcast_own, 1, 0);
+        orig_node->bcast_own_sum[batman_if->if_num] = bit_packet_count(bcast_own);
         debug_output(4) << "new = " << orig_node->bcast_own_sum[batman_if->if_num] << "\n";
     }
 }
@@ -90,6 +90,9 @@ static int lc_print(struct lc_graph *LC, char *buf);
 
 static inline void __lc_link_del(struct lc_graph *lc, struct lc_link *link)
 {
+    /* The graph changes, so the cached shortest paths are stale */
+    lc->src = NULL;
+
     /* Also free the nodes if they lack other links */
     if (--link->src->links == 0)
         __tbl_del(&lc->nodes, &link->src->l);
@@ -262,6 +265,8 @@ static inline struct lc_link *__lc_link_find(struct tbl *t, struct in_addr src,
     return (struct lc_link *)__tbl_find(t, &q, crit_link_query);
 }
 
+/* Returns 1 for a new link, 2 if the cost of an existing link changed and
+ * 0 if only its timeout was refreshed */
 static int __lc_link_tbl_add(struct tbl *t, struct lc_node *src,
                              struct lc_node *dst, usecs_t timeout,
                              int status, int cost)
@@ -293,6 +298,8 @@ static int __lc_link_tbl_add(struct tbl *t, struct lc_node *src,
 
         res = 1;
     }
+    else if (link->cost != (unsigned int)cost)
+        res = 2;
     else
         res = 0;
 
@@ -344,6 +351,10 @@ int NSCLASS lc_link_add(struct in_addr src, struct in_addr dst,
 
     res = __lc_link_tbl_add(&LC.links, sn, dn, timeout, status, cost);
 
+    /* A new link or a new cost invalidates the cached shortest paths */
+    if (res > 0)
+        LC.src = NULL;
+
     if (res)
     {
 #ifdef LC_TIMER
@@ -482,8 +493,10 @@ struct dsr_srt *NSCLASS lc_srt_find(struct in_addr src, struct in_addr dst)
 
     DSR_WRITE_LOCK(&LC.lock);
 
-    /*  if (!LC.src || LC.src->addr.s_addr != src.s_addr) */
-    __dijkstra(src);
+    /* The node costs and predecessors of the last run stay valid until the
+     * link cache changes, which resets LC.src */
+    if (!LC.src || LC.src->addr.s_addr != src.s_addr)
+        __dijkstra(src);
 
     dst_node = (struct lc_node *)__tbl_find(&LC.nodes, &dst, crit_addr);
 
@@ -159,7 +159,7 @@ class DYMOUM : public ManetRoutingBase
     // cMessage messageEvent;
 
     typedef std::map<MACAddress, unsigned int> MacToIpAddress;
-    typedef std::multimap<simtime_t, struct timer*> DymoTimerMap;
+    typedef ManetTimerQueue<struct timer> DymoTimerMap;
     typedef std::map<ManetAddress, rtable_entry_t *> DymoRoutingTable;
     typedef std::map<ManetAddress, pending_rreq_t * > DymoPendingRreq;
     typedef std::vector<nb_t *> DymoNbList;
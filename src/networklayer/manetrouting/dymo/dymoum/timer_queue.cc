@@ -58,10 +58,7 @@ int NS_CLASS timer_init(struct timer *t, timeout_func_t f, void *data)
 int NS_CLASS timer_is_queued(struct timer *t)
 {
     if (t)
-        for (DymoTimerMap::iterator i = dymoTimerList->begin(); i != dymoTimerList->end(); i++)
-        {
-            if ((*i).second == t)return 1;
-        }
+        return t->used ? 1 : 0;
     return 0;
 }
 
@@ -71,15 +68,11 @@ int NS_CLASS timer_add(struct timer *t)
     if (!t || !t->handler)
         return -1;
 
-    // If the timer is already in the queue we firstly remove it
-    if (t->used)
-        timer_remove(t);
-    t->used = 1;
-
     simtime_t timeout = t->timeout.tv_sec;
     timeout += ((double)(t->timeout.tv_usec)/1000000.0);
 
-    dymoTimerList->insert(std::make_pair(timeout,t));
+    // If the timer is already in the queue it is moved to the new timeout
+    dymoTimerList->insert(timeout, t);
     return DLIST_SUCCESS;
 }
 
@@ -89,15 +82,8 @@ int NS_CLASS timer_remove(struct timer *t)
     if (!t)
         return -1;
 
-    t->used = 0;
-    for (DymoTimerMap::iterator i = dymoTimerList->begin(); i != dymoTimerList->end(); i++)
-    {
-        if ((*i).second == t)
-        {
-            dymoTimerList->erase(i);
-            return DLIST_SUCCESS;
-        }
-    }
+    if (dymoTimerList->remove(t))
+        return DLIST_SUCCESS;
     return DLIST_FAILURE;
 }
 
@@ -119,10 +105,9 @@ int NS_CLASS timer_set_timeout(struct timer *t, long msec)
 void NS_CLASS timer_timeout(struct timeval *now)
 {
 
-    while (!dymoTimerList->empty() && (timeval_diff(&(dymoTimerList->begin()->second->timeout), now) <= 0))
+    while (!dymoTimerList->empty() && (timeval_diff(&(dymoTimerList->getFirst()->timeout), now) <= 0))
     {
-        struct timer * t = dymoTimerList->begin()->second;
-        dymoTimerList->erase(dymoTimerList->begin());
+        struct timer * t = dymoTimerList->popFirst();
         if (t==NULL)
             opp_error ("timer ower is bad");
         else
@@ -142,12 +127,12 @@ struct timeval *NS_CLASS timer_age_queue()
 
     while (!dymoTimerList->empty())
     {
-        t = dymoTimerList->begin()->second;
+        t = dymoTimerList->getFirst();
         if (t==NULL)
             opp_error ("timer ower is bad");
         if (timeval_diff(&(t->timeout), &now)>0)
             break;
-        dymoTimerList->erase(dymoTimerList->begin());
+        dymoTimerList->popFirst();
         if (t->handler)
             (this->*t->handler)(t->data);
     }
@@ -155,8 +140,8 @@ struct timeval *NS_CLASS timer_age_queue()
     if (dymoTimerList->empty())
         return NULL;
 
-    t = dymoTimerList->begin()->second;
-    if (timeval_diff(&(dymoTimerList->begin()->second->timeout), &now)<=0)
+    t = dymoTimerList->getFirst();
+    if (timeval_diff(&(t->timeout), &now)<=0)
         opp_error("Dymo Time queue error");
     remaining.tv_usec   = (t->timeout.tv_usec - now.tv_usec);
     remaining.tv_sec    = (t->timeout.tv_sec - now.tv_sec);
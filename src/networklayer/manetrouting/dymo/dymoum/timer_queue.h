@@ -41,6 +41,7 @@ struct timer
     struct timeval  timeout;
     timeout_func_t  handler;
     void        *data;
+    ManetTimerQueue<struct timer>::iterator queuePos;
 };
 
 #else
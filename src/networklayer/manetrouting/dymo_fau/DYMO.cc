@@ -1081,11 +1081,11 @@ bool DYMO::updateRoutesFromAddressBlock(const DYMO_AddressBlock& ab, bool isRREQ
     DYMO_RoutingEntry* entry = dymo_routingTable->getForAddress(IPv4Address(ab.getAddress()));
     if (entry && !isRBlockBetter(entry, ab, isRREQ)) return false;
 
-    if (!entry)
+    bool isNewEntry = !entry;
+    if (isNewEntry)
     {
         ev << "adding routing entry for " << IPv4Address(ab.getAddress()) << endl;
         entry = new DYMO_RoutingEntry(this);
-        dymo_routingTable->addRoute(entry);
     }
     else
     {
@@ -1098,6 +1098,12 @@ bool DYMO::updateRoutesFromAddressBlock(const DYMO_AddressBlock& ab, bool isRREQ
     entry->routeNextHopAddress = IPv4Address(nextHopAddress);
     entry->routeNextHopInterface = nextHopInterface;
     entry->routePrefix = ab.hasPrefix() ? ab.getPrefix() : 32;
+
+    // the table indexes entries by address and prefix, so add or re-index only now
+    if (isNewEntry)
+        dymo_routingTable->addRoute(entry);
+    else
+        dymo_routingTable->updateRoute(entry);
     entry->routeBroken = false;
     entry->routeAgeMin.start(ROUTE_AGE_MIN_TIMEOUT);
     entry->routeAgeMax.start(ROUTE_AGE_MAX_TIMEOUT);
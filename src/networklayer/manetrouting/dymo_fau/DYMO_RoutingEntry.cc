@@ -21,13 +21,19 @@
 #include "DYMO.h"
 
 DYMO_RoutingEntry::DYMO_RoutingEntry(DYMO* dymo) :
+    routeSeqNum(0),
     routeNextHopInterface(NULL),
+    routeBroken(false),
+    routeDist(0),
+    routePrefix(32),
     routeAgeMin(dymo, "routeAgeMin"),
     routeAgeMax(dymo, "routeAgeMax"),
     routeNew(dymo, "routeNew"),
     routeUsed(dymo, "routeUsed"),
     routeDelete(dymo, "routeDelete"),
-    dymo(dymo)
+    dymo(dymo),
+    indexedPrefix(0),
+    indexedAddress(0)
 {
 }
 
@@ -75,6 +75,11 @@ class DYMO_RoutingEntry
   protected:
     DYMO* dymo; /**< DYMO module */
 
+    int indexedPrefix; /**< routePrefix under which DYMO_RoutingTable has indexed this entry */
+    uint32 indexedAddress; /**< routeAddress masked to indexedPrefix */
+
+    friend class DYMO_RoutingTable;
+
   public:
     friend std::ostream& operator<<(std::ostream& os, const DYMO_RoutingEntry& e);
     bool hasActiveTimer() { return routeAgeMin.isActive() || routeAgeMax.isActive() || routeNew.isActive() || routeUsed.isActive() || routeDelete.isActive(); }
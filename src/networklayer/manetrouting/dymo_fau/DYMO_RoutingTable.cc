@@ -115,6 +115,20 @@ DYMO_RoutingEntry* DYMO_RoutingTable::getRoute(int k)
 void DYMO_RoutingTable::addRoute(DYMO_RoutingEntry *entry)
 {
     routeVector.push_back(entry);
+    indexRoute(entry);
+}
+
+//=================================================================================================
+/*
+ * Function must be called after routeAddress or routePrefix of an entry has been modified
+ */
+//=================================================================================================
+void DYMO_RoutingTable::updateRoute(DYMO_RoutingEntry *entry)
+{
+    if (entry->indexedPrefix == entry->routePrefix && entry->indexedAddress == makeKey(entry->routePrefix, entry->routeAddress).second)
+        return;
+    unindexRoute(entry);
+    indexRoute(entry);
 }
 
 //=================================================================================================
@@ -137,6 +151,7 @@ void DYMO_RoutingTable::deleteRoute(DYMO_RoutingEntry *entry)
         if (entry == *iter)
         {
             routeVector.erase(iter);
+            unindexRoute(entry);
             ManetAddress dest(entry->routeAddress);
             dymoProcess->omnet_chg_rte(dest, dest, dest, 0, true);
             //updateDisplayString();
@@ -154,11 +169,13 @@ void DYMO_RoutingTable::deleteRoute(DYMO_RoutingEntry *entry)
 //=================================================================================================
 void DYMO_RoutingTable::maintainAssociatedRoutingTable()
 {
+    dymoProcess->beginRouteUpdate();
     RouteVector::iterator iter;
     for (iter = routeVector.begin(); iter < routeVector.end(); iter++)
     {
         maintainAssociatedRoutingEntryFor(*iter);
     }
+    dymoProcess->endRouteUpdate();
 }
 
 //=================================================================================================
@@ -167,17 +184,36 @@ void DYMO_RoutingTable::maintainAssociatedRoutingTable()
 //=================================================================================================
 DYMO_RoutingEntry* DYMO_RoutingTable::getByAddress(IPv4Address addr)
 {
+    // an entry with routeAddress==addr is indexed under addr masked to its own prefix length
+    DYMO_RoutingEntry *found = 0;
+    for (PrefixLengthCount::iterator it = prefixLengths.begin(); it != prefixLengths.end(); ++it)
+    {
+        bool ambiguous = false;
+        DYMO_RoutingEntry *entry = findIndexed(it->first, addr, true, ambiguous);
+        if (ambiguous || (entry && found))
+            return scanForAddress(addr, true);
+        if (entry)
+            found = entry;
+    }
 
-    RouteVector::iterator iter;
+    return found;
+}
 
-    for (iter = routeVector.begin(); iter < routeVector.end(); iter++)
+//=================================================================================================
+/*
+ */
+//=================================================================================================
+DYMO_RoutingEntry* DYMO_RoutingTable::getForAddress(IPv4Address addr)
+{
+    // try the prefix lengths in the table from the longest one down
+    for (PrefixLengthCount::reverse_iterator it = prefixLengths.rbegin(); it != prefixLengths.rend() && it->first > 0; ++it)
     {
-        DYMO_RoutingEntry *entry = *iter;
-
-        if (entry->routeAddress == addr)
-        {
+        bool ambiguous = false;
+        DYMO_RoutingEntry *entry = findIndexed(it->first, addr, false, ambiguous);
+        if (ambiguous)
+            return scanForAddress(addr, false);
+        if (entry)
             return entry;
-        }
     }
 
     return 0;
@@ -187,10 +223,74 @@ DYMO_RoutingEntry* DYMO_RoutingTable::getByAddress(IPv4Address addr)
 /*
  */
 //=================================================================================================
-DYMO_RoutingEntry* DYMO_RoutingTable::getForAddress(IPv4Address addr)
+DYMO_RoutingTable::RouteKey DYMO_RoutingTable::makeKey(int prefix, const IPv4Address& addr)
+{
+    // same masking as IPv4Address::prefixMatches()
+    if (prefix < 1)
+        return RouteKey(prefix, 0);
+    if (prefix > 31)
+        return RouteKey(prefix, addr.getInt());
+    return RouteKey(prefix, addr.getInt() & IPv4Address::makeNetmask(prefix).getInt());
+}
+
+void DYMO_RoutingTable::indexRoute(DYMO_RoutingEntry *entry)
+{
+    RouteKey key = makeKey(entry->routePrefix, entry->routeAddress);
+    entry->indexedPrefix = key.first;
+    entry->indexedAddress = key.second;
+    routeIndex.insert(std::make_pair(key, entry));
+    prefixLengths[key.first]++;
+}
+
+void DYMO_RoutingTable::unindexRoute(DYMO_RoutingEntry *entry)
+{
+    RouteKey key(entry->indexedPrefix, entry->indexedAddress);
+    std::pair<RouteIndex::iterator, RouteIndex::iterator> range = routeIndex.equal_range(key);
+    for (RouteIndex::iterator it = range.first; it != range.second; ++it)
+    {
+        if (it->second == entry)
+        {
+            routeIndex.erase(it);
+            if (--prefixLengths[key.first] == 0)
+                prefixLengths.erase(key.first);
+            return;
+        }
+    }
+    throw cRuntimeError("routing entry not found in the routing table index");
+}
+
+DYMO_RoutingEntry* DYMO_RoutingTable::findIndexed(int prefix, const IPv4Address& addr, bool exact, bool& ambiguous)
+{
+    DYMO_RoutingEntry *found = 0;
+    std::pair<RouteIndex::iterator, RouteIndex::iterator> range = routeIndex.equal_range(makeKey(prefix, addr));
+    for (RouteIndex::iterator it = range.first; it != range.second; ++it)
+    {
+        if (exact && it->second->routeAddress != addr)
+            continue;
+        if (found)
+        {
+            ambiguous = true;
+            return 0;
+        }
+        found = it->second;
+    }
+    return found;
+}
+
+DYMO_RoutingEntry* DYMO_RoutingTable::scanForAddress(const IPv4Address& addr, bool exact)
 {
     RouteVector::iterator iter;
 
+    if (exact)
+    {
+        for (iter = routeVector.begin(); iter < routeVector.end(); iter++)
+        {
+            if ((*iter)->routeAddress == addr)
+                return *iter;
+        }
+        return 0;
+    }
+
     int longestPrefix = 0;
     DYMO_RoutingEntry* longestPrefixEntry = 0;
     for (iter = routeVector.begin(); iter < routeVector.end(); iter++)
@@ -20,6 +20,7 @@
 #ifndef DYMO_ROUTINGTABLE_H
 #define DYMO_ROUTINGTABLE_H
 
+#include <map>
 #include <vector>
 
 #include "INETDefs.h"
@@ -55,6 +56,8 @@ class DYMO_RoutingTable : public cObject
     DYMO_RoutingEntry* getRoute(int k);
     /** @adds a new entry to the table **/
     void addRoute(DYMO_RoutingEntry *entry);
+    /** @updates the lookup index after routeAddress or routePrefix of an entry in the table changed **/
+    void updateRoute(DYMO_RoutingEntry *entry);
     /** @deletes an entry from the table **/
     void deleteRoute(DYMO_RoutingEntry *entry);
     /** @removes invalid routes from the network layer routing table **/
@@ -68,8 +71,24 @@ class DYMO_RoutingTable : public cObject
 
   private:
     typedef std::vector<DYMO_RoutingEntry *> RouteVector;
+    typedef std::pair<int, uint32> RouteKey;  // prefix length, masked address
+    typedef std::multimap<RouteKey, DYMO_RoutingEntry *> RouteIndex;
+    typedef std::map<int, int> PrefixLengthCount;
     RouteVector routeVector;
+    RouteIndex routeIndex;  // entries by routePrefix and masked routeAddress
+    PrefixLengthCount prefixLengths;  // number of entries for each routePrefix in routeIndex
     DYMO *dymoProcess;
+
+    static RouteKey makeKey(int prefix, const IPv4Address& addr);
+    void indexRoute(DYMO_RoutingEntry *entry);
+    void unindexRoute(DYMO_RoutingEntry *entry);
+    /**
+     * returns the entry indexed under (prefix, addr), with routeAddress==addr if exact is set;
+     * sets ambiguous and returns 0 if there are several
+     */
+    DYMO_RoutingEntry* findIndexed(int prefix, const IPv4Address& addr, bool exact, bool& ambiguous);
+    /** original linear search of the table; resolves ambiguous index lookups in table order **/
+    DYMO_RoutingEntry* scanForAddress(const IPv4Address& addr, bool exact);
     /**
      * add or delete network layer routing table entry for given DYMO routing table entry, based on whether it's valid
      */
@@ -77,6 +77,7 @@ OLSR_Timer::OLSR_Timer(OLSR* agent) : cOwnedObject("OLSR_Timer")
 {
     agent_ = agent;
     tuple_ = NULL;
+    used = 0;
 }
 
 OLSR_Timer::~OLSR_Timer()
@@ -90,25 +91,19 @@ OLSR_Timer::OLSR_Timer() : cOwnedObject("OLSR_Timer")
     if (agent_==NULL)
         opp_error("timer ower is bad");
     tuple_ = NULL;
+    used = 0;
 }
 
 void OLSR_Timer::removeQueueTimer()
 {
-    TimerQueue::iterator it;
-    for (it=agent_->timerQueuePtr->begin(); it != agent_->timerQueuePtr->end(); it++ )
-    {
-        if (it->second==this)
-        {
-            agent_->timerQueuePtr->erase(it);
-            return;
-        }
-    }
+    if (used)
+        agent_->timerQueuePtr->remove(this);
 }
 
 void OLSR_Timer::resched(double time)
 {
     removeQueueTimer();
-    agent_->timerQueuePtr->insert(std::pair<simtime_t, OLSR_Timer *>(simTime()+time, this));
+    agent_->timerQueuePtr->insert(simTime()+time, this);
     //if (this->isScheduled())
     //  agent_->cancelEvent(this);
     // agent_->scheduleAt (simTime()+time,this);
@@ -124,7 +119,7 @@ OLSR_HelloTimer::expire()
 {
     agent_->send_hello();
     // agent_->scheduleAt(simTime()+agent_->hello_ival_- JITTER,this);
-    agent_->timerQueuePtr->insert(std::pair<simtime_t, OLSR_Timer *>(simTime()+agent_->hello_ival_- agent_->jitter(), this));
+    agent_->timerQueuePtr->insert(simTime()+agent_->hello_ival_- agent_->jitter(), this);
 }
 
 ///
@@ -137,7 +132,7 @@ OLSR_TcTimer::expire()
     if (agent_->mprselset().size() > 0)
         agent_->send_tc();
     // agent_->scheduleAt(simTime()+agent_->tc_ival_- JITTER,this);
-    agent_->timerQueuePtr->insert(std::pair<simtime_t, OLSR_Timer *>(simTime()+agent_->tc_ival_- agent_->jitter(), this));
+    agent_->timerQueuePtr->insert(simTime()+agent_->tc_ival_- agent_->jitter(), this);
 
 }
 
@@ -154,7 +149,7 @@ OLSR_MidTimer::expire()
         return; // not multi-interface support
     agent_->send_mid();
 //  agent_->scheduleAt(simTime()+agent_->mid_ival_- JITTER,this);
-    agent_->timerQueuePtr->insert(std::pair<simtime_t, OLSR_Timer *>(simTime()+agent_->mid_ival_- agent_->jitter(), this));
+    agent_->timerQueuePtr->insert(simTime()+agent_->mid_ival_- agent_->jitter(), this);
 #endif
 }
 
@@ -180,7 +175,7 @@ OLSR_DupTupleTimer::expire()
     else
     {
         // agent_->scheduleAt (simTime()+DELAY_T(time),this);
-        agent_->timerQueuePtr->insert(std::pair<simtime_t, OLSR_Timer *>(simTime()+DELAY_T(time), this));
+        agent_->timerQueuePtr->insert(simTime()+DELAY_T(time), this);
     }
 }
 
@@ -230,16 +225,20 @@ OLSR_LinkTupleTimer::expire()
     else if (tuple->sym_time() < now)
     {
         if (first_time_)
+        {
+            // the link became asymmetric, routes through it must be recomputed
             first_time_ = false;
+            agent_->setTopologyChanged(true);
+        }
         else
             agent_->nb_loss(tuple);
         // agent_->scheduleAt (simTime()+DELAY_T(tuple_->time()),this);
-        agent_->timerQueuePtr->insert(std::pair<simtime_t, OLSR_Timer *>(simTime()+DELAY_T(tuple->time()), this));
+        agent_->timerQueuePtr->insert(simTime()+DELAY_T(tuple->time()), this);
     }
     else
     {
         // agent_->scheduleAt (simTime()+DELAY_T(MIN(tuple_->time(), tuple_->sym_time())),this);
-        agent_->timerQueuePtr->insert(std::pair<simtime_t, OLSR_Timer *>(simTime()+DELAY_T(MIN(tuple->time(), tuple->sym_time())), this));
+        agent_->timerQueuePtr->insert(simTime()+DELAY_T(MIN(tuple->time(), tuple->sym_time())), this);
     }
 }
 
@@ -278,7 +277,7 @@ OLSR_Nb2hopTupleTimer::expire()
     else
     {
         // agent_->scheduleAt (simTime()+DELAY_T(time),this);
-        agent_->timerQueuePtr->insert(std::pair<simtime_t, OLSR_Timer *>(simTime()+DELAY_T(time), this));
+        agent_->timerQueuePtr->insert(simTime()+DELAY_T(time), this);
     }
 }
 
@@ -319,7 +318,7 @@ OLSR_MprSelTupleTimer::expire()
     else
     {
 //      agent_->scheduleAt (simTime()+DELAY_T(time),this);
-        agent_->timerQueuePtr->insert(std::pair<simtime_t, OLSR_Timer *>(simTime()+DELAY_T(time), this));
+        agent_->timerQueuePtr->insert(simTime()+DELAY_T(time), this);
     }
 }
 
@@ -359,7 +358,7 @@ OLSR_TopologyTupleTimer::expire()
     else
     {
 //      agent_->scheduleAt (simTime()+DELAY_T(time),this);
-        agent_->timerQueuePtr->insert(std::pair<simtime_t, OLSR_Timer *>(simTime()+DELAY_T(time), this));
+        agent_->timerQueuePtr->insert(simTime()+DELAY_T(time), this);
     }
 }
 
@@ -396,7 +395,7 @@ void OLSR_IfaceAssocTupleTimer::expire()
     else
     {
         //  agent_->scheduleAt (simTime()+DELAY_T(time),this);
-        agent_->timerQueuePtr->insert(std::pair<simtime_t, OLSR_Timer *>(simTime()+DELAY_T(time), this));
+        agent_->timerQueuePtr->insert(simTime()+DELAY_T(time), this);
     }
 }
 
@@ -483,6 +482,7 @@ OLSR::initialize(int stage)
 
         timerMessage = new cMessage();
         timerQueuePtr = new TimerQueue;
+        topologyChange = true;
 
 
         useIndex = par("UseIndex");
@@ -541,14 +541,14 @@ void OLSR::handleMessage(cMessage *msg)
     if (msg->isSelfMessage())
     {
         //OLSR_Timer *timer=dynamic_cast<OLSR_Timer*>(msg);
-        while (timerQueuePtr->begin()->first<=simTime())
+        while (!timerQueuePtr->empty() && timerQueuePtr->getFirstExpiry()<=simTime())
         {
-            OLSR_Timer *timer = timerQueuePtr->begin()->second;
+            OLSR_Timer *timer = timerQueuePtr->getFirst();
             if (timer==NULL)
                 opp_error("timer ower is bad");
             else
             {
-                timerQueuePtr->erase(timerQueuePtr->begin());
+                timerQueuePtr->popFirst();
                 timer->expire();
             }
         }
@@ -692,13 +692,25 @@ OLSR::recv_olsr(cMessage* msg)
         OLSR_dup_tuple* duplicated = state_.find_dup_tuple(msg.orig_addr(), msg.msg_seq_num());
         if (duplicated == NULL)
         {
-            // Process the message according to its type
+            // Process the message according to its type. HELLO and MID messages
+            // update link, neighbor and interface tuples in place, so they always
+            // trigger a route recomputation; TC messages only when they changed
+            // the topology set.
             if (msg.msg_type() == OLSR_HELLO_MSG)
+            {
                 process_hello(msg, receiverIfaceAddr, src_addr, index);
+                setTopologyChanged(true);
+            }
             else if (msg.msg_type() == OLSR_TC_MSG)
-                process_tc(msg, src_addr, index);
+            {
+                if (process_tc(msg, src_addr, index))
+                    setTopologyChanged(true);
+            }
             else if (msg.msg_type() == OLSR_MID_MSG)
+            {
                 process_mid(msg, src_addr, index);
+                setTopologyChanged(true);
+            }
             else
             {
                 debug("%f: Node %s can not process OLSR packet because does not "
@@ -737,7 +749,9 @@ OLSR::recv_olsr(cMessage* msg)
     delete op;
 
     // After processing all OLSR messages, we must recompute routing table
-    rtable_computation();
+    // if the messages or expired tuples changed anything it depends on
+    if (getTopologyChanged())
+        rtable_computation();
 }
 
 
@@ -1260,6 +1274,8 @@ OLSR::mpr_computation()
 void
 OLSR::rtable_computation()
 {
+    beginRouteUpdate();
+
     // 1. All the entries from the routing table are removed.
     rtable_.clear();
     omnet_clean_rte(); // clean IP tables
@@ -1448,6 +1464,7 @@ OLSR::rtable_computation()
         if (!added)
             break;
     }
+    endRouteUpdate();
     setTopologyChanged(false);
 }
 
@@ -1510,7 +1527,7 @@ OLSR::process_tc(OLSR_msg& msg, const nsaddr_t &sender_iface, const int &index)
     //  T_last_addr == originator address AND
     //  T_seq       <  ANSN
     // MUST be removed from the topology set.
-    state_.erase_older_topology_tuples(msg.orig_addr(), tc.ansn());
+    bool changed = state_.erase_older_topology_tuples(msg.orig_addr(), tc.ansn());
 
     // 4. For each of the advertised neighbor main address received in
     // the TC message:
@@ -1546,9 +1563,10 @@ OLSR::process_tc(OLSR_msg& msg, const nsaddr_t &sender_iface, const int &index)
             OLSR_TopologyTupleTimer* topology_timer =
                 new OLSR_TopologyTupleTimer(this, topology_tuple);
             topology_timer->resched(DELAY(topology_tuple->time()));
+            changed = true;
         }
     }
-    return false;
+    return changed;
 }
 
 ///
@@ -2808,8 +2826,7 @@ OLSR::~OLSR()
 
     while (timerQueuePtr && timerQueuePtr->size()>0)
     {
-        OLSR_Timer * timer = timerQueuePtr->begin()->second;
-        timerQueuePtr->erase(timerQueuePtr->begin());
+        OLSR_Timer * timer = timerQueuePtr->popFirst();
         timer->setTuple(NULL);
         if (helloTimer==timer)
             helloTimer = NULL;
@@ -2940,20 +2957,22 @@ bool OLSR::getDestAddress(cPacket *msg, ManetAddress &dest)
 
 void OLSR::scheduleNextEvent()
 {
-    TimerQueue::iterator e = timerQueuePtr->begin();
+    if (timerQueuePtr->empty())
+        return;
+    simtime_t firstExpiry = timerQueuePtr->getFirstExpiry();
     if (timerMessage->isScheduled())
     {
-        if (e->first < timerMessage->getArrivalTime())
+        if (firstExpiry < timerMessage->getArrivalTime())
         {
             cancelEvent(timerMessage);
-            scheduleAt(e->first, timerMessage);
+            scheduleAt(firstExpiry, timerMessage);
         }
-        else if (e->first>timerMessage->getArrivalTime())
+        else if (firstExpiry>timerMessage->getArrivalTime())
             error("OLSR timer Queue problem");
     }
     else
     {
-        scheduleAt(e->first, timerMessage);
+        scheduleAt(firstExpiry, timerMessage);
     }
 }
 
@@ -165,6 +165,9 @@ class OLSR_Timer :  public cOwnedObject /*cMessage*/
   protected:
     OLSR*       agent_; ///< OLSR agent which created the timer.
     cObject* tuple_;
+    int used;   ///< nonzero while queued in the agent's timer queue
+    ManetTimerQueue<OLSR_Timer>::iterator queuePos;
+    friend class ManetTimerQueue<OLSR_Timer>;
   public:
 
     virtual void removeTimer();
@@ -335,8 +338,7 @@ class OLSR_IfaceAssocTupleTimer : public OLSR_Timer
 /// internal state.
 ///
 
-typedef std::set<OLSR_Timer *> TimerPendingList;
-typedef std::multimap <simtime_t, OLSR_Timer *> TimerQueue;
+typedef ManetTimerQueue<OLSR_Timer> TimerQueue;
 
 
 class OLSR : public ManetRoutingBase
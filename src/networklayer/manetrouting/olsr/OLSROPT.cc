@@ -289,7 +289,7 @@ OLSROPT::update_topology_tuples(OLSR_msg msg, int index)
             }
             if (!foundTuple){ // the tuple was not in present in the TC, erase it
                 changedTuples++;
-                it = topologyset().erase(it); // erase and increment iterator
+                it = state_.erase_topology_tuple(it); // erase and increment iterator
                 continue;
             }else{
                 it++;
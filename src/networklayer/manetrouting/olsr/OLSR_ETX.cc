@@ -77,7 +77,7 @@ void OLSR_ETX_LinkQualityTimer::expire()
     OLSR_ETX *agentaux = check_and_cast<OLSR_ETX *>(agent_);
     agentaux->OLSR_ETX::link_quality();
     // agentaux->scheduleAt(simTime()+agentaux->hello_ival_,this);
-    agentaux->timerQueuePtr->insert(std::pair<simtime_t, OLSR_Timer *>(simTime()+agentaux->hello_ival_, this));
+    agentaux->timerQueuePtr->insert(simTime()+agentaux->hello_ival_, this);
 }
 
 
@@ -160,6 +160,7 @@ OLSR_ETX::initialize(int stage)
 
         timerMessage = new cMessage();
         timerQueuePtr = new TimerQueue;
+        topologyChange = true;
 
         // Starts all timers
 
@@ -1209,6 +1210,8 @@ OLSR_ETX::rtable_dijkstra_computation()
     // Declare a class that will run the dijkstra algorithm
     Dijkstra *dijkstra = new Dijkstra();
 
+    beginRouteUpdate();
+
     // All the entries from the routing table are removed.
     rtable_.clear();
     omnet_clean_rte();
@@ -1431,6 +1434,7 @@ OLSR_ETX::rtable_dijkstra_computation()
 
         }
     }
+    endRouteUpdate();
     // rtable_.print_debug(this);
     // destroy the dijkstra class we've created
     // dijkstra->clear ();
@@ -2662,8 +2666,7 @@ OLSR_ETX::~OLSR_ETX()
 
     while (timerQueuePtr && timerQueuePtr->size()>0)
     {
-        OLSR_Timer * timer = timerQueuePtr->begin()->second;
-        timerQueuePtr->erase(timerQueuePtr->begin());
+        OLSR_Timer * timer = timerQueuePtr->popFirst();
         timer->setTuple(NULL);
         if (helloTimer==timer)
             helloTimer = NULL;
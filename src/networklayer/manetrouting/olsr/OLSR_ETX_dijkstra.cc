@@ -26,6 +26,8 @@
 
 /*** New File Added ***/
 
+#include <algorithm>
+
 #include <OLSR_ETX_dijkstra.h>
 #include <OLSR_ETX.h>
 
@@ -86,58 +88,6 @@ void Dijkstra::add_edge(const nsaddr_t & dest_node, const nsaddr_t & last_node,
     nonprocessed_nodes_->insert(dest_node);
 }
 
-Dijkstra::NodesSet::iterator Dijkstra::best_cost()
-{
-    NodesSet::iterator best = nonprocessed_nodes_->end();
-
-    // Search for a node that was not processed yet and that has
-    // the best cost to be reached from the node running dijkstra...
-    NodesSet::iterator it;
-    for (it = nonprocessed_nodes_->begin(); it != nonprocessed_nodes_->end(); it++)
-    {
-        DijkstraMap::iterator itDij = dijkstraMap.find(*it);
-        if (itDij==dijkstraMap.end())
-            opp_error("dijkstraMap error");
-        if (itDij->second.hop_count() == -1) // there is no such link yet, i. e., it's cost is infinite...
-            continue;
-        if (best == nonprocessed_nodes_->end())
-            best = it;
-        else
-        {
-            DijkstraMap::iterator itBest = dijkstraMap.find(*best);
-            if (itBest==dijkstraMap.end())
-                opp_error("dijkstraMap error");
-            if (parameter->link_delay())
-            {
-                /// Link quality extension
-                if (itDij->second.link().getDelay() < itBest->second.link().getDelay())
-                    best = it;
-            }
-            else
-            {
-                switch (parameter->link_quality())
-                {
-                case OLSR_ETX_BEHAVIOR_ETX:
-                    if (itDij->second.link().quality() < itBest->second.link().quality())
-                        best = it;
-                    break;
-
-                case OLSR_ETX_BEHAVIOR_ML:
-                    if (itDij->second.link().quality() > itBest->second.link().quality())
-                        best = it;
-                    break;
-
-                case OLSR_ETX_BEHAVIOR_NONE:
-                default:
-                    //
-                    break;
-                }
-            }
-        }
-    }
-    return best;
-}
-
 edge* Dijkstra::get_edge(const nsaddr_t & dest_node, const nsaddr_t & last_node)
 {
     // Find the edge that connects dest_node and last_node
@@ -153,144 +103,207 @@ edge* Dijkstra::get_edge(const nsaddr_t & dest_node, const nsaddr_t & last_node)
     return NULL;
 }
 
-void Dijkstra::run()
+bool Dijkstra::relax(hop& dest, hop& current, edge* current_edge)
 {
-    // While there are non processed nodes...
-    while (nonprocessed_nodes_->begin() != nonprocessed_nodes_->end())
+    bool changed = false;
+    if (dest.hop_count() == -1)   // there is not a link to dest_node yet...
     {
-        // Get the node among those nom processed having best cost...
-        NodesSet::iterator current_node = best_cost();
-        // If all non processed nodes have cost equals to infinite, there is
-        // nothing left to do, but abort (this might be the case of a not
-        // fully connected graph)
-        if (current_node == nonprocessed_nodes_->end())
+        switch (parameter->link_quality())
+        {
+        case OLSR_ETX_BEHAVIOR_ETX:
+            dest.link().last_node() = current_edge->last_node();
+            dest.link().quality() = current.link().quality() + current_edge->quality();
+            /// Link delay extension
+            dest.link().getDelay() = current.link().getDelay() + current_edge->getDelay();
+            dest.hop_count() = current.hop_count() + 1;
+            changed = true;
+            // Keep track of the highest path we have by means of number of hops...
+            if (dest.hop_count() > highest_hop_)
+                highest_hop_ = dest.hop_count();
+            break;
+
+        case OLSR_ETX_BEHAVIOR_ML:
+            dest.link().last_node() = current_edge->last_node();
+            dest.link().quality() = current.link().quality() * current_edge->quality();
+            /// Link delay extension
+            dest.link().getDelay() = current.link().getDelay() + current_edge->getDelay();
+            dest.hop_count() = current.hop_count() + 1;
+            changed = true;
+            // Keep track of the highest path we have by means of number of hops...
+            if (dest.hop_count() > highest_hop_)
+                highest_hop_ = dest.hop_count();
             break;
 
-        // for each node in all_nodes...
-        for (NodesSet::iterator dest_node = all_nodes_->begin(); dest_node != all_nodes_->end(); dest_node++)
+        case OLSR_ETX_BEHAVIOR_NONE:
+        default:
+            //
+            break;
+        }
+    }
+    else
+    {
+        if (parameter->link_delay())
         {
-            // ... not processed yet...
-            if (nonprocessed_nodes_->find(*dest_node) == nonprocessed_nodes_->end())
-                continue;
-            // .. and adjacent to 'current_node'...
-            // note: edge has destination '*dest_node' and last hop '*current_node'
-            edge* current_edge = get_edge(*dest_node, *current_node);
-            if (current_edge == NULL)
-                continue;
-            // D(node) = min (D(node), D(current_node) + edge(current_node, node).cost())
-            DijkstraMap::iterator itDest = dijkstraMap.find(*dest_node);
-            if (itDest==dijkstraMap.end())
-                opp_error("dijkstraMap error node not found");
-            DijkstraMap::iterator itCurrent = dijkstraMap.find(*current_node);
-            if (itCurrent==dijkstraMap.end())
-                opp_error("dijkstraMap error node not found");
-            // hop destHop = itDest->second;
-            // hop currentHop = itCurrent->second;
-            if (itDest->second.hop_count() == -1)   // there is not a link to dest_node yet...
+            /// Link delay extension
+            switch (parameter->link_quality())
             {
-                switch (parameter->link_quality())
+            case OLSR_ETX_BEHAVIOR_ETX:
+                if (current.link().getDelay() + current_edge->getDelay() < dest.link().getDelay())
                 {
-                case OLSR_ETX_BEHAVIOR_ETX:
-                    itDest->second.link().last_node() = current_edge->last_node();
-                    itDest->second.link().quality() = itCurrent->second.link().quality() + current_edge->quality();
-                    /// Link delay extension
-                    itDest->second.link().getDelay() = itCurrent->second.link().getDelay() + current_edge->getDelay();
-                    itDest->second.hop_count() = itCurrent->second.hop_count() + 1;
+                    dest.link().last_node() = current_edge->last_node();
+                    dest.link().quality() = current.link().quality() + current_edge->quality();
+                    dest.link().getDelay() = current.link().getDelay() + current_edge->getDelay();
+                    dest.hop_count() = current.hop_count() + 1;
+                    changed = true;
                     // Keep track of the highest path we have by means of number of hops...
-                    if (itDest->second.hop_count() > highest_hop_)
-                        highest_hop_ = itDest->second.hop_count();
-                    break;
-
-                case OLSR_ETX_BEHAVIOR_ML:
-                    itDest->second.link().last_node() = current_edge->last_node();
-                    itDest->second.link().quality() = itCurrent->second.link().quality() * current_edge->quality();
-                    /// Link delay extension
-                    itDest->second.link().getDelay() = itCurrent->second.link().getDelay() + current_edge->getDelay();
-                    itDest->second.hop_count() = itCurrent->second.hop_count() + 1;
+                    if (dest.hop_count() > highest_hop_)
+                        highest_hop_ = dest.hop_count();
+                }
+                break;
+
+            case OLSR_ETX_BEHAVIOR_ML:
+                if (current.link().getDelay() + current_edge->getDelay() < dest.link().getDelay())
+                {
+                    dest.link().last_node() = current_edge->last_node();
+                    dest.link().quality() = current.link().quality() * current_edge->quality();
+                    dest.link().getDelay() = current.link().getDelay() + current_edge->getDelay();
+                    dest.hop_count() = current.hop_count() + 1;
+                    changed = true;
                     // Keep track of the highest path we have by means of number of hops...
-                    if (itDest->second.hop_count() > highest_hop_)
-                        highest_hop_ = itDest->second.hop_count();
-                    break;
-
-                case OLSR_ETX_BEHAVIOR_NONE:
-                default:
-                    //
-                    break;
+                    if (dest.hop_count() > highest_hop_)
+                        highest_hop_ = dest.hop_count();
                 }
+                break;
+
+            case OLSR_ETX_BEHAVIOR_NONE:
+            default:
+                //
+                break;
             }
-            else
+        }
+        else
+        {
+            switch (parameter->link_quality())
             {
-                if (parameter->link_delay())
+            case OLSR_ETX_BEHAVIOR_ETX:
+                if (current.link().quality() + current_edge->quality() < dest.link().quality())
                 {
-                    /// Link delay extension
-                    switch (parameter->link_quality())
-                    {
-                    case OLSR_ETX_BEHAVIOR_ETX:
-                        if (itCurrent->second.link().getDelay() + current_edge->getDelay() < itDest->second.link().getDelay())
-                        {
-                            itDest->second.link().last_node() = current_edge->last_node();
-                            itDest->second.link().quality() = itCurrent->second.link().quality() + current_edge->quality();
-                            itDest->second.link().getDelay() = itCurrent->second.link().getDelay() + current_edge->getDelay();
-                            itDest->second.hop_count() = itCurrent->second.hop_count() + 1;
-                            // Keep track of the highest path we have by means of number of hops...
-                            if (itDest->second.hop_count() > highest_hop_)
-                                highest_hop_ = itDest->second.hop_count();
-                        }
-                        break;
-
-                    case OLSR_ETX_BEHAVIOR_ML:
-                        if (itCurrent->second.link().getDelay() + current_edge->getDelay() < itDest->second.link().getDelay())
-                        {
-                            itDest->second.link().last_node() = current_edge->last_node();
-                            itDest->second.link().quality() = itCurrent->second.link().quality() * current_edge->quality();
-                            itDest->second.link().getDelay() = itCurrent->second.link().getDelay() + current_edge->getDelay();
-                            itDest->second.hop_count() = itCurrent->second.hop_count() + 1;
-                            // Keep track of the highest path we have by means of number of hops...
-                            if (itDest->second.hop_count() > highest_hop_)
-                                highest_hop_ = itDest->second.hop_count();
-                        }
-                        break;
-
-                    case OLSR_ETX_BEHAVIOR_NONE:
-                    default:
-                        //
-                        break;
-                    }
+                    dest.link().last_node() = current_edge->last_node();
+                    dest.link().quality() = current.link().quality() + current_edge->quality();
+                    dest.hop_count() = current.hop_count() + 1;
+                    changed = true;
+                    // Keep track of the highest path we have by means of number of hops...
+                    if (dest.hop_count() > highest_hop_)
+                        highest_hop_ = dest.hop_count();
                 }
-                else
+                break;
+
+            case OLSR_ETX_BEHAVIOR_ML:
+                if (current.link().quality() * current_edge->quality() > dest.link().quality())
                 {
-                    switch (parameter->link_quality())
-                    {
-                    case OLSR_ETX_BEHAVIOR_ETX:
-                        if (itCurrent->second.link().quality() + current_edge->quality() < itDest->second.link().quality())
-                        {
-                            itDest->second.link().last_node() = current_edge->last_node();
-                            itDest->second.link().quality() = itCurrent->second.link().quality() + current_edge->quality();
-                            itDest->second.hop_count() = itCurrent->second.hop_count() + 1;
-                            // Keep track of the highest path we have by means of number of hops...
-                            if (itDest->second.hop_count() > highest_hop_)
-                                highest_hop_ = itDest->second.hop_count();
-                        }
-                        break;
-
-                    case OLSR_ETX_BEHAVIOR_ML:
-                        if (itCurrent->second.link().quality() * current_edge->quality() > itDest->second.link().quality())
-                        {
-                            itDest->second.link().last_node() = current_edge->last_node();
-                            itDest->second.link().quality() = itCurrent->second.link().quality() * current_edge->quality();
-                            itDest->second.hop_count() = itCurrent->second.hop_count() + 1;
-                            // Keep track of the highest path we have by means of number of hops...
-                            if (itDest->second.hop_count() > highest_hop_)
-                                highest_hop_ = itDest->second.hop_count();
-                        }
-                        break;
-
-                    case OLSR_ETX_BEHAVIOR_NONE:
-                    default:
-                        //
-                        break;
-                    }
+                    dest.link().last_node() = current_edge->last_node();
+                    dest.link().quality() = current.link().quality() * current_edge->quality();
+                    dest.hop_count() = current.hop_count() + 1;
+                    changed = true;
+                    // Keep track of the highest path we have by means of number of hops...
+                    if (dest.hop_count() > highest_hop_)
+                        highest_hop_ = dest.hop_count();
                 }
+                break;
+
+            case OLSR_ETX_BEHAVIOR_NONE:
+            default:
+                //
+                break;
+            }
+        }
+    }
+    return changed;
+}
+
+double Dijkstra::cost_key(hop& node)
+{
+    if (parameter->link_delay())
+        return node.link().getDelay();
+    switch (parameter->link_quality())
+    {
+    case OLSR_ETX_BEHAVIOR_ETX:
+        return node.link().quality();
+    case OLSR_ETX_BEHAVIOR_ML:
+        return -node.link().quality();   // higher quality is better
+    case OLSR_ETX_BEHAVIOR_NONE:
+    default:
+        return 0;
+    }
+}
+
+void Dijkstra::push_candidate(std::vector<HeapEntry>& heap, const nsaddr_t & node, hop& h)
+{
+    HeapEntry entry;
+    entry.key = cost_key(h);
+    entry.node = node;
+    heap.push_back(entry);
+    std::push_heap(heap.begin(), heap.end(), HeapCompare());
+}
+
+void Dijkstra::run()
+{
+    // Index the edges by their last hop, so that processing a node only
+    // visits the edges leaving it. Like get_edge(), use the first edge
+    // added between two nodes.
+    OutLinkArray out_links;
+    for (LinkArray::iterator it = link_array_->begin(); it != link_array_->end(); it++)
+    {
+        for (std::vector<edge*>::iterator e = it->second.begin(); e != it->second.end(); e++)
+        {
+            if (get_edge(it->first, (*e)->last_node()) == *e)
+                out_links[(*e)->last_node()].push_back(std::make_pair(it->first, *e));
+        }
+    }
+
+    // Candidates ordered by cost, then by address as best_cost() breaks ties.
+    // Improving a node pushes a new entry; outdated entries are skipped when popped.
+    std::vector<HeapEntry> heap;
+    for (NodesSet::iterator it = nonprocessed_nodes_->begin(); it != nonprocessed_nodes_->end(); it++)
+    {
+        hop& h = dijkstraMap[*it];
+        if (h.hop_count() != -1)
+            push_candidate(heap, *it, h);
+    }
+
+    // If all non processed nodes have cost equals to infinite, the heap runs
+    // empty and there is nothing left to do (this might be the case of a not
+    // fully connected graph)
+    while (!heap.empty())
+    {
+        // Get the node among those non processed having best cost...
+        std::pop_heap(heap.begin(), heap.end(), HeapCompare());
+        HeapEntry top = heap.back();
+        heap.pop_back();
+
+        NodesSet::iterator current_node = nonprocessed_nodes_->find(top.node);
+        if (current_node == nonprocessed_nodes_->end())
+            continue;
+        DijkstraMap::iterator itCurrent = dijkstraMap.find(top.node);
+        if (itCurrent==dijkstraMap.end())
+            opp_error("dijkstraMap error node not found");
+        if (cost_key(itCurrent->second) != top.key)
+            continue;
+
+        // for each node not processed yet and adjacent to 'current_node'...
+        OutLinkArray::iterator out = out_links.find(top.node);
+        if (out != out_links.end())
+        {
+            for (std::vector<std::pair<nsaddr_t, edge*> >::iterator it = out->second.begin(); it != out->second.end(); it++)
+            {
+                if (nonprocessed_nodes_->find(it->first) == nonprocessed_nodes_->end())
+                    continue;
+                DijkstraMap::iterator itDest = dijkstraMap.find(it->first);
+                if (itDest==dijkstraMap.end())
+                    opp_error("dijkstraMap error node not found");
+                // D(node) = min (D(node), D(current_node) + edge(current_node, node).cost())
+                if (relax(itDest->second, itCurrent->second, it->second))
+                    push_candidate(heap, it->first, itDest->second);
             }
         }
         // Remove it from the list of processed nodes
@@ -66,12 +66,30 @@ class Dijkstra : public cOwnedObject
   private:
     typedef std::set<nsaddr_t> NodesSet;
     typedef std::map<nsaddr_t, std::vector<edge*> > LinkArray;
+    typedef std::map<nsaddr_t, std::vector<std::pair<nsaddr_t, edge*> > > OutLinkArray;
+
+    /// Entry of the candidate heap used by run()
+    struct HeapEntry
+    {
+        double key;
+        nsaddr_t node;
+    };
+    struct HeapCompare
+    {
+        bool operator()(const HeapEntry& a, const HeapEntry& b) const
+        {
+            return a.key > b.key || (a.key == b.key && b.node < a.node);
+        }
+    };
+
     NodesSet * nonprocessed_nodes_;
     LinkArray * link_array_;
     int highest_hop_;
 
-    NodesSet::iterator best_cost();
     edge* get_edge(const nsaddr_t &, const nsaddr_t &);
+    bool relax(hop& dest, hop& current, edge* current_edge);
+    double cost_key(hop& node);
+    void push_candidate(std::vector<HeapEntry>& heap, const nsaddr_t & node, hop& h);
     OLSR_ETX_parameter *parameter;
 
   public:
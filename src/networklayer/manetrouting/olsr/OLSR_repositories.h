@@ -31,6 +31,7 @@
 #define __OLSR_repositories_h__
 
 #include <string.h>
+#include <map>
 #include <set>
 #include <vector>
 
@@ -329,7 +330,7 @@ typedef std::vector<OLSR_link_tuple*>       linkset_t;  ///< Link Set type.
 typedef std::vector<OLSR_nb_tuple*>     nbset_t;    ///< Neighbor Set type.
 typedef std::vector<OLSR_nb2hop_tuple*>     nb2hopset_t;    ///< 2-hop Neighbor Set type.
 typedef std::vector<OLSR_topology_tuple*>   topologyset_t;  ///< Topology Set type.
-typedef std::vector<OLSR_dup_tuple*>        dupset_t;   ///< Duplicate Set type.
+typedef std::map<std::pair<nsaddr_t, uint16_t>, OLSR_dup_tuple*> dupset_t; ///< Duplicate Set type, keyed by originator address and sequence number.
 typedef std::vector<OLSR_iface_assoc_tuple*>    ifaceassocset_t; ///< Interface Association Set type.
 
 #endif
@@ -26,61 +26,86 @@
 ///     state of an OLSR node.
 ///
 
+#include <algorithm>
+
 #include "OLSR_state.h"
 #include "OLSR.h"
 
-/********** MPR Selector Set Manipulation **********/
+/********** Index helpers **********/
 
-OLSR_mprsel_tuple*
-OLSR_state::find_mprsel_tuple(const nsaddr_t &main_addr)
+/// Returns the first tuple indexed under the given address, or NULL.
+template <class Index>
+static typename Index::mapped_type first_indexed(Index& index, const nsaddr_t & key)
 {
-    for (mprselset_t::iterator it = mprselset_.begin(); it != mprselset_.end(); it++)
-    {
-        OLSR_mprsel_tuple* tuple = *it;
-        if (tuple->main_addr() == main_addr)
-            return tuple;
-    }
+    typename Index::iterator it = index.lower_bound(key);
+    if (it != index.end() && it->first == key)
+        return it->second;
     return NULL;
 }
 
-void
-OLSR_state::erase_mprsel_tuple(OLSR_mprsel_tuple* tuple)
+/// Removes the index entry of the given tuple.
+template <class Index, class Tuple>
+static void unindex_tuple(Index& index, const nsaddr_t & key, Tuple* tuple)
 {
-    for (mprselset_t::iterator it = mprselset_.begin(); it != mprselset_.end(); it++)
+    std::pair<typename Index::iterator, typename Index::iterator> range = index.equal_range(key);
+    for (typename Index::iterator it = range.first; it != range.second; it++)
     {
-        if (*it == tuple)
+        if (it->second == tuple)
         {
-            mprselset_.erase(it);
-            break;
+            index.erase(it);
+            return;
         }
     }
 }
 
+/// Removes the given tuple from a set, keeping the order of the others.
+template <class Set, class Tuple>
+static void erase_from_set(Set& set, Tuple* tuple)
+{
+    typename Set::iterator it = std::find(set.begin(), set.end(), tuple);
+    if (it != set.end())
+        set.erase(it);
+}
+
+/********** MPR Selector Set Manipulation **********/
+
+OLSR_mprsel_tuple*
+OLSR_state::find_mprsel_tuple(const nsaddr_t &main_addr)
+{
+    return first_indexed(mprselindex_, main_addr);
+}
+
+void
+OLSR_state::erase_mprsel_tuple(OLSR_mprsel_tuple* tuple)
+{
+    unindex_tuple(mprselindex_, tuple->main_addr(), tuple);
+    erase_from_set(mprselset_, tuple);
+}
+
 bool
 OLSR_state::erase_mprsel_tuples(const nsaddr_t & main_addr)
 {
-    bool topologyChanged = false;
+    std::pair<mprselindex_t::iterator, mprselindex_t::iterator> range = mprselindex_.equal_range(main_addr);
+    if (range.first == range.second)
+        return false;
+    mprselindex_.erase(range.first, range.second);
+
     for (mprselset_t::iterator it = mprselset_.begin(); it != mprselset_.end();)
     {
         OLSR_mprsel_tuple* tuple = *it;
         if (tuple->main_addr() == main_addr)
-        {
             it = mprselset_.erase(it);
-            topologyChanged = true;
-            if (mprselset_.empty())
-                break;
-        }
         else
             it++;
-
     }
-    return topologyChanged;
+    return true;
 }
 
 void
 OLSR_state::insert_mprsel_tuple(OLSR_mprsel_tuple* tuple)
 {
     mprselset_.push_back(tuple);
+    mprselindex_.insert(std::make_pair(tuple->main_addr(), tuple));
 }
 
 /********** Neighbor Set Manipulation **********/
@@ -88,22 +113,17 @@ OLSR_state::insert_mprsel_tuple(OLSR_mprsel_tuple* tuple)
 OLSR_nb_tuple*
 OLSR_state::find_nb_tuple(const nsaddr_t & main_addr)
 {
-    for (nbset_t::iterator it = nbset_.begin(); it != nbset_.end(); it++)
-    {
-        OLSR_nb_tuple* tuple = *it;
-        if (tuple->nb_main_addr() == main_addr)
-            return tuple;
-    }
-    return NULL;
+    return first_indexed(nbindex_, main_addr);
 }
 
 OLSR_nb_tuple*
 OLSR_state::find_sym_nb_tuple(const nsaddr_t & main_addr)
 {
-    for (nbset_t::iterator it = nbset_.begin(); it != nbset_.end(); it++)
+    std::pair<nbindex_t::iterator, nbindex_t::iterator> range = nbindex_.equal_range(main_addr);
+    for (nbindex_t::iterator it = range.first; it != range.second; it++)
     {
-        OLSR_nb_tuple* tuple = *it;
-        if (tuple->nb_main_addr() == main_addr && tuple->getStatus() == OLSR_STATUS_SYM)
+        OLSR_nb_tuple* tuple = it->second;
+        if (tuple->getStatus() == OLSR_STATUS_SYM)
             return tuple;
     }
     return NULL;
@@ -112,10 +132,11 @@ OLSR_state::find_sym_nb_tuple(const nsaddr_t & main_addr)
 OLSR_nb_tuple*
 OLSR_state::find_nb_tuple(const nsaddr_t & main_addr, uint8_t willingness)
 {
-    for (nbset_t::iterator it = nbset_.begin(); it != nbset_.end(); it++)
+    std::pair<nbindex_t::iterator, nbindex_t::iterator> range = nbindex_.equal_range(main_addr);
+    for (nbindex_t::iterator it = range.first; it != range.second; it++)
     {
-        OLSR_nb_tuple* tuple = *it;
-        if (tuple->nb_main_addr() == main_addr && tuple->willingness() == willingness)
+        OLSR_nb_tuple* tuple = it->second;
+        if (tuple->willingness() == willingness)
             return tuple;
     }
     return NULL;
@@ -124,34 +145,23 @@ OLSR_state::find_nb_tuple(const nsaddr_t & main_addr, uint8_t willingness)
 void
 OLSR_state::erase_nb_tuple(OLSR_nb_tuple* tuple)
 {
-    for (nbset_t::iterator it = nbset_.begin(); it != nbset_.end(); it++)
-    {
-        if (*it == tuple)
-        {
-            nbset_.erase(it);
-            break;
-        }
-    }
+    unindex_tuple(nbindex_, tuple->nb_main_addr(), tuple);
+    erase_from_set(nbset_, tuple);
 }
 
 void
 OLSR_state::erase_nb_tuple(const nsaddr_t & main_addr)
 {
-    for (nbset_t::iterator it = nbset_.begin(); it != nbset_.end(); it++)
-    {
-        OLSR_nb_tuple* tuple = *it;
-        if (tuple->nb_main_addr() == main_addr)
-        {
-            it = nbset_.erase(it);
-            break;
-        }
-    }
+    OLSR_nb_tuple* tuple = find_nb_tuple(main_addr);
+    if (tuple != NULL)
+        erase_nb_tuple(tuple);
 }
 
 void
 OLSR_state::insert_nb_tuple(OLSR_nb_tuple* tuple)
 {
     nbset_.push_back(tuple);
+    nbindex_.insert(std::make_pair(tuple->nb_main_addr(), tuple));
 }
 
 /********** Neighbor 2 Hop Set Manipulation **********/
@@ -159,10 +169,11 @@ OLSR_state::insert_nb_tuple(OLSR_nb_tuple* tuple)
 OLSR_nb2hop_tuple*
 OLSR_state::find_nb2hop_tuple(const nsaddr_t & nb_main_addr, const nsaddr_t & nb2hop_addr)
 {
-    for (nb2hopset_t::iterator it = nb2hopset_.begin(); it != nb2hopset_.end(); it++)
+    std::pair<nb2hopindex_t::iterator, nb2hopindex_t::iterator> range = nb2hopindex_.equal_range(nb_main_addr);
+    for (nb2hopindex_t::iterator it = range.first; it != range.second; it++)
     {
-        OLSR_nb2hop_tuple* tuple = *it;
-        if (tuple->nb_main_addr() == nb_main_addr && tuple->nb2hop_addr() == nb2hop_addr)
+        OLSR_nb2hop_tuple* tuple = it->second;
+        if (tuple->nb2hop_addr() == nb2hop_addr)
             return tuple;
     }
     return NULL;
@@ -171,33 +182,26 @@ OLSR_state::find_nb2hop_tuple(const nsaddr_t & nb_main_addr, const nsaddr_t & nb
 void
 OLSR_state::erase_nb2hop_tuple(OLSR_nb2hop_tuple* tuple)
 {
-    for (nb2hopset_t::iterator it = nb2hopset_.begin(); it != nb2hopset_.end(); it++)
-    {
-        if (*it == tuple)
-        {
-            nb2hopset_.erase(it);
-            break;
-        }
-    }
+    unindex_tuple(nb2hopindex_, tuple->nb_main_addr(), tuple);
+    erase_from_set(nb2hopset_, tuple);
 }
 
 bool
 OLSR_state::erase_nb2hop_tuples(const nsaddr_t & nb_main_addr, const nsaddr_t & nb2hop_addr)
 {
     bool returnValue = false;
-    for (nb2hopset_t::iterator it = nb2hopset_.begin(); it != nb2hopset_.end();)
+    std::pair<nb2hopindex_t::iterator, nb2hopindex_t::iterator> range = nb2hopindex_.equal_range(nb_main_addr);
+    for (nb2hopindex_t::iterator it = range.first; it != range.second;)
     {
-        OLSR_nb2hop_tuple* tuple = *it;
-        if (tuple->nb_main_addr() == nb_main_addr && tuple->nb2hop_addr() == nb2hop_addr)
+        OLSR_nb2hop_tuple* tuple = it->second;
+        if (tuple->nb2hop_addr() == nb2hop_addr)
         {
-            it = nb2hopset_.erase(it);
+            nb2hopindex_.erase(it++);
+            erase_from_set(nb2hopset_, tuple);
             returnValue = true;
-            if (nb2hopset_.empty())
-                break;
         }
         else
             it++;
-
     }
     return returnValue;
 }
@@ -205,28 +209,27 @@ OLSR_state::erase_nb2hop_tuples(const nsaddr_t & nb_main_addr, const nsaddr_t &
 bool
 OLSR_state::erase_nb2hop_tuples(const nsaddr_t & nb_main_addr)
 {
-    bool topologyChanged = false;
+    std::pair<nb2hopindex_t::iterator, nb2hopindex_t::iterator> range = nb2hopindex_.equal_range(nb_main_addr);
+    if (range.first == range.second)
+        return false;
+    nb2hopindex_.erase(range.first, range.second);
+
     for (nb2hopset_t::iterator it = nb2hopset_.begin(); it != nb2hopset_.end();)
     {
         OLSR_nb2hop_tuple* tuple = *it;
         if (tuple->nb_main_addr() == nb_main_addr)
-        {
             it = nb2hopset_.erase(it);
-            topologyChanged = true;
-            if (nb2hopset_.empty())
-                break;
-        }
         else
             it++;
-
     }
-    return topologyChanged;
+    return true;
 }
 
 void
 OLSR_state::insert_nb2hop_tuple(OLSR_nb2hop_tuple* tuple)
 {
     nb2hopset_.push_back(tuple);
+    nb2hopindex_.insert(std::make_pair(tuple->nb_main_addr(), tuple));
 }
 
 /********** MPR Set Manipulation **********/
@@ -255,32 +258,24 @@ OLSR_state::clear_mprset()
 OLSR_dup_tuple*
 OLSR_state::find_dup_tuple(const nsaddr_t & addr, uint16_t seq_num)
 {
-    for (dupset_t::iterator it = dupset_.begin(); it != dupset_.end(); it++)
-    {
-        OLSR_dup_tuple* tuple = *it;
-        if (tuple->getAddr() == addr && tuple->seq_num() == seq_num)
-            return tuple;
-    }
+    dupset_t::iterator it = dupset_.find(std::make_pair(addr, seq_num));
+    if (it != dupset_.end())
+        return it->second;
     return NULL;
 }
 
 void
 OLSR_state::erase_dup_tuple(OLSR_dup_tuple* tuple)
 {
-    for (dupset_t::iterator it = dupset_.begin(); it != dupset_.end(); it++)
-    {
-        if (*it == tuple)
-        {
-            dupset_.erase(it);
-            break;
-        }
-    }
+    dupset_t::iterator it = dupset_.find(std::make_pair(tuple->getAddr(), tuple->seq_num()));
+    if (it != dupset_.end() && it->second == tuple)
+        dupset_.erase(it);
 }
 
 void
 OLSR_state::insert_dup_tuple(OLSR_dup_tuple* tuple)
 {
-    dupset_.push_back(tuple);
+    dupset_[std::make_pair(tuple->getAddr(), tuple->seq_num())] = tuple;
 }
 
 /********** Link Set Manipulation **********/
@@ -288,49 +283,30 @@ OLSR_state::insert_dup_tuple(OLSR_dup_tuple* tuple)
 OLSR_link_tuple*
 OLSR_state::find_link_tuple(const nsaddr_t & iface_addr)
 {
-    for (linkset_t::iterator it = linkset_.begin(); it != linkset_.end(); it++)
-    {
-        OLSR_link_tuple* tuple = *it;
-        if (tuple->nb_iface_addr() == iface_addr)
-            return tuple;
-    }
-    return NULL;
+    return first_indexed(linkindex_, iface_addr);
 }
 
 OLSR_link_tuple*
 OLSR_state::find_sym_link_tuple(const nsaddr_t & iface_addr, double now)
 {
-    for (linkset_t::iterator it = linkset_.begin(); it != linkset_.end(); it++)
-    {
-        OLSR_link_tuple* tuple = *it;
-        if (tuple->nb_iface_addr() == iface_addr)
-        {
-            if (tuple->sym_time() > now)
-                return tuple;
-            else
-                break;
-        }
-    }
+    OLSR_link_tuple* tuple = first_indexed(linkindex_, iface_addr);
+    if (tuple != NULL && tuple->sym_time() > now)
+        return tuple;
     return NULL;
 }
 
 void
 OLSR_state::erase_link_tuple(OLSR_link_tuple* tuple)
 {
-    for (linkset_t::iterator it = linkset_.begin(); it != linkset_.end(); it++)
-    {
-        if (*it == tuple)
-        {
-            linkset_.erase(it);
-            break;
-        }
-    }
+    unindex_tuple(linkindex_, tuple->nb_iface_addr(), tuple);
+    erase_from_set(linkset_, tuple);
 }
 
 void
 OLSR_state::insert_link_tuple(OLSR_link_tuple* tuple)
 {
     linkset_.push_back(tuple);
+    linkindex_.insert(std::make_pair(tuple->nb_iface_addr(), tuple));
 }
 
 /********** Topology Set Manipulation **********/
@@ -338,10 +314,11 @@ OLSR_state::insert_link_tuple(OLSR_link_tuple* tuple)
 OLSR_topology_tuple*
 OLSR_state::find_topology_tuple(const nsaddr_t & dest_addr, const nsaddr_t & last_addr)
 {
-    for (topologyset_t::iterator it = topologyset_.begin(); it != topologyset_.end(); it++)
+    std::pair<topologyindex_t::iterator, topologyindex_t::iterator> range = topologyindex_.equal_range(last_addr);
+    for (topologyindex_t::iterator it = range.first; it != range.second; it++)
     {
-        OLSR_topology_tuple* tuple = *it;
-        if (tuple->dest_addr() == dest_addr && tuple->last_addr() == last_addr)
+        OLSR_topology_tuple* tuple = it->second;
+        if (tuple->dest_addr() == dest_addr)
             return tuple;
     }
     return NULL;
@@ -350,10 +327,11 @@ OLSR_state::find_topology_tuple(const nsaddr_t & dest_addr, const nsaddr_t & las
 OLSR_topology_tuple*
 OLSR_state::find_newer_topology_tuple(const nsaddr_t &last_addr, uint16_t ansn)
 {
-    for (topologyset_t::iterator it = topologyset_.begin(); it != topologyset_.end(); it++)
+    std::pair<topologyindex_t::iterator, topologyindex_t::iterator> range = topologyindex_.equal_range(last_addr);
+    for (topologyindex_t::iterator it = range.first; it != range.second; it++)
     {
-        OLSR_topology_tuple* tuple = *it;
-        if (tuple->last_addr() == last_addr && tuple->seq() > ansn)
+        OLSR_topology_tuple* tuple = it->second;
+        if (tuple->seq() > ansn)
             return tuple;
     }
     return NULL;
@@ -362,15 +340,18 @@ OLSR_state::find_newer_topology_tuple(const nsaddr_t &last_addr, uint16_t ansn)
 void
 OLSR_state::erase_topology_tuple(OLSR_topology_tuple* tuple)
 {
-    for (topologyset_t::iterator it = topologyset_.begin(); it != topologyset_.end(); it++)
-    {
-        if (*it == tuple)
-        {
-            topologyset_.erase(it);
-            break;
-        }
-    }
+    unindex_tuple(topologyindex_, tuple->last_addr(), tuple);
+    erase_from_set(topologyset_, tuple);
+}
+
+topologyset_t::iterator
+OLSR_state::erase_topology_tuple(topologyset_t::iterator it)
+{
+    OLSR_topology_tuple* tuple = *it;
+    unindex_tuple(topologyindex_, tuple->last_addr(), tuple);
+    return topologyset_.erase(it);
 }
+
 std::ostream& operator<<(std::ostream& out, const OLSR_topology_tuple& tuple)
 {
     out << "Tuple index: " << tuple.index;
@@ -403,28 +384,40 @@ OLSR_state::print_topology_tuples_across(const nsaddr_t & last_addr)
             std::cout << " -- " << *tuple;
     }
 }
-void
+bool
 OLSR_state::erase_older_topology_tuples(const nsaddr_t & last_addr, uint16_t ansn)
 {
+    bool erased = false;
+    std::pair<topologyindex_t::iterator, topologyindex_t::iterator> range = topologyindex_.equal_range(last_addr);
+    for (topologyindex_t::iterator it = range.first; it != range.second;)
+    {
+        if (it->second->seq() < ansn)
+        {
+            topologyindex_.erase(it++);
+            erased = true;
+        }
+        else
+            it++;
+    }
+    if (!erased)
+        return false;
+
     for (topologyset_t::iterator it = topologyset_.begin(); it != topologyset_.end();)
     {
         OLSR_topology_tuple* tuple = *it;
         if (tuple->last_addr() == last_addr && tuple->seq() < ansn)
-        {
             it = topologyset_.erase(it);
-            if (topologyset_.empty())
-                break;
-        }
         else
             it++;
-
     }
+    return true;
 }
 
 void
 OLSR_state::insert_topology_tuple(OLSR_topology_tuple* tuple)
 {
     topologyset_.push_back(tuple);
+    topologyindex_.insert(std::make_pair(tuple->last_addr(), tuple));
 }
 
 /********** Interface Association Set Manipulation **********/
@@ -432,36 +425,21 @@ OLSR_state::insert_topology_tuple(OLSR_topology_tuple* tuple)
 OLSR_iface_assoc_tuple*
 OLSR_state::find_ifaceassoc_tuple(const nsaddr_t & iface_addr)
 {
-    for (ifaceassocset_t::iterator it = ifaceassocset_.begin();
-            it != ifaceassocset_.end();
-            it++)
-    {
-        OLSR_iface_assoc_tuple* tuple = *it;
-        if (tuple->iface_addr() == iface_addr)
-            return tuple;
-    }
-    return NULL;
+    return first_indexed(ifaceassocindex_, iface_addr);
 }
 
 void
 OLSR_state::erase_ifaceassoc_tuple(OLSR_iface_assoc_tuple* tuple)
 {
-    for (ifaceassocset_t::iterator it = ifaceassocset_.begin();
-            it != ifaceassocset_.end();
-            it++)
-    {
-        if (*it == tuple)
-        {
-            ifaceassocset_.erase(it);
-            break;
-        }
-    }
+    unindex_tuple(ifaceassocindex_, tuple->iface_addr(), tuple);
+    erase_from_set(ifaceassocset_, tuple);
 }
 
 void
 OLSR_state::insert_ifaceassoc_tuple(OLSR_iface_assoc_tuple* tuple)
 {
     ifaceassocset_.push_back(tuple);
+    ifaceassocindex_.insert(std::make_pair(tuple->iface_addr(), tuple));
 }
 
 void OLSR_state::clear_all()
@@ -485,7 +463,7 @@ void OLSR_state::clear_all()
         delete (*it);
     mprselset_.clear();
     for (dupset_t::iterator it = dupset_.begin(); it != dupset_.end(); it++)
-        delete (*it);
+        delete it->second;
 
     dupset_.clear();
     for (ifaceassocset_t::iterator it = ifaceassocset_.begin(); it != ifaceassocset_.end(); it++)
@@ -493,6 +471,12 @@ void OLSR_state::clear_all()
     ifaceassocset_.clear();
     mprset_.clear();
 
+    linkindex_.clear();
+    nbindex_.clear();
+    nb2hopindex_.clear();
+    topologyindex_.clear();
+    mprselindex_.clear();
+    ifaceassocindex_.clear();
 }
 
 OLSR_state::OLSR_state(OLSR_state * st)
@@ -500,25 +484,25 @@ OLSR_state::OLSR_state(OLSR_state * st)
     for (linkset_t::iterator it = st->linkset_.begin(); it != st->linkset_.end(); it++)
     {
         OLSR_link_tuple* tuple = *it;
-        linkset_.push_back(tuple->dup());
+        insert_link_tuple(tuple->dup());
     }
 
     for (nbset_t::iterator it = st->nbset_.begin(); it != st->nbset_.end(); it++)
     {
         OLSR_nb_tuple* tuple = *it;
-        nbset_.push_back(tuple->dup());
+        insert_nb_tuple(tuple->dup());
     }
 
     for (nb2hopset_t::iterator it = st->nb2hopset_.begin(); it != st->nb2hopset_.end(); it++)
     {
         OLSR_nb2hop_tuple* tuple = *it;
-        nb2hopset_.push_back(tuple->dup());
+        insert_nb2hop_tuple(tuple->dup());
     }
 
     for (topologyset_t::iterator it = st->topologyset_.begin(); it != st->topologyset_.end(); it++)
     {
         OLSR_topology_tuple* tuple = *it;
-        topologyset_.push_back(tuple->dup());
+        insert_topology_tuple(tuple->dup());
     }
 
     for (mprset_t::iterator it = st->mprset_.begin(); it != st->mprset_.end(); it++)
@@ -529,19 +513,19 @@ OLSR_state::OLSR_state(OLSR_state * st)
     for (mprselset_t::iterator it = st->mprselset_.begin(); it != st->mprselset_.end(); it++)
     {
         OLSR_mprsel_tuple* tuple = *it;
-        mprselset_.push_back(tuple->dup());
+        insert_mprsel_tuple(tuple->dup());
     }
 
     for (dupset_t::iterator it = st->dupset_.begin(); it != st->dupset_.end(); it++)
     {
-        OLSR_dup_tuple* tuple = *it;
-        dupset_.push_back(tuple->dup());
+        OLSR_dup_tuple* tuple = it->second;
+        insert_dup_tuple(tuple->dup());
     }
 
     for (ifaceassocset_t::iterator it = st->ifaceassocset_.begin(); it != st->ifaceassocset_.end(); it++)
     {
         OLSR_iface_assoc_tuple* tuple = *it;
-        ifaceassocset_.push_back(tuple->dup());
+        insert_ifaceassoc_tuple(tuple->dup());
     }
 }
 
@@ -550,4 +534,3 @@ OLSR_state::~OLSR_state()
 {
     clear_all();
 }
-
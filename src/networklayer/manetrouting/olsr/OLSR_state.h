@@ -45,6 +45,24 @@ class OLSR_state : public cObject
     dupset_t    dupset_;    ///< Duplicate Set (RFC 3626, section 3.4).
     ifaceassocset_t ifaceassocset_; ///< Interface Association Set (RFC 3626, section 4.1).
 
+    /// Address indexes over the sets above, so that the find_*() methods do not scan
+    /// whole sets. They are maintained by the insert_*() and erase_*() methods, so tuples
+    /// must not be added to or removed from the sets directly. Tuples with equal keys keep
+    /// their insertion order, so lookups return the same tuple as a scan of the set.
+    typedef std::multimap<nsaddr_t, OLSR_link_tuple*> linkindex_t;
+    typedef std::multimap<nsaddr_t, OLSR_nb_tuple*> nbindex_t;
+    typedef std::multimap<nsaddr_t, OLSR_nb2hop_tuple*> nb2hopindex_t;
+    typedef std::multimap<nsaddr_t, OLSR_topology_tuple*> topologyindex_t;
+    typedef std::multimap<nsaddr_t, OLSR_mprsel_tuple*> mprselindex_t;
+    typedef std::multimap<nsaddr_t, OLSR_iface_assoc_tuple*> ifaceassocindex_t;
+
+    linkindex_t linkindex_;     ///< Link Set by neighbor interface address.
+    nbindex_t   nbindex_;       ///< Neighbor Set by neighbor main address.
+    nb2hopindex_t   nb2hopindex_;   ///< 2-hop Neighbor Set by neighbor main address.
+    topologyindex_t topologyindex_; ///< Topology Set by last address.
+    mprselindex_t   mprselindex_;   ///< MPR Selector Set by main address.
+    ifaceassocindex_t ifaceassocindex_; ///< Interface Association Set by interface address.
+
     inline  linkset_t&      linkset()   { return linkset_; }
     inline  mprset_t&       mprset()    { return mprset_; }
     inline  mprselset_t&        mprselset() { return mprselset_; }
@@ -88,7 +106,8 @@ class OLSR_state : public cObject
     OLSR_topology_tuple*    find_topology_tuple(const nsaddr_t &, const  nsaddr_t &);
     OLSR_topology_tuple*    find_newer_topology_tuple(const nsaddr_t &, uint16_t);
     void            erase_topology_tuple(OLSR_topology_tuple*);
-    void            erase_older_topology_tuples(const nsaddr_t &, uint16_t);
+    topologyset_t::iterator erase_topology_tuple(topologyset_t::iterator);
+    bool            erase_older_topology_tuples(const nsaddr_t &, uint16_t);
     void             print_topology_tuples_to(const nsaddr_t & dest_addr);
     void             print_topology_tuples_across(const nsaddr_t & last_addr);
     void            insert_topology_tuple(OLSR_topology_tuple*);
@@ -17,13 +17,17 @@
 #include "LIBTable.h"
 #include "XMLUtils.h"
 #include "RoutingTableAccess.h"
+#include "InterfaceTableAccess.h"
 
 Define_Module(LIBTable);
 
 void LIBTable::initialize(int stage)
 {
     if (stage==0)
+    {
         maxLabel = 0;
+        ift = InterfaceTableAccess().get();
+    }
 
     // we have to wait until routerId gets assigned in stage 3
     if (stage==4)
@@ -45,26 +49,58 @@ void LIBTable::handleMessage(cMessage *)
     ASSERT(false);
 }
 
-bool LIBTable::resolveLabel(std::string inInterface, int inLabel,
-        LabelOpVector& outLabel, std::string& outInterface, int& color)
+int LIBTable::resolveInterfaceId(const std::string& interfaceName)
 {
-    bool any = (inInterface.length() == 0);
+    // names that are not interfaces (e.g. "any" used by RSVP) give -1,
+    // which never matches the interface of an incoming packet
+    InterfaceEntry *ie = interfaceName.empty() ? NULL : ift->getInterfaceByName(interfaceName.c_str());
+    return ie ? ie->getInterfaceId() : -1;
+}
 
-    for (unsigned int i = 0; i < lib.size(); i++)
-    {
-        if (!any && lib[i].inInterface != inInterface)
-            continue;
+void LIBTable::addLibEntry(const LIBEntry& entry)
+{
+    ASSERT(entry.inLabel > 0);
 
-        if (lib[i].inLabel != inLabel)
-            continue;
+    if (entry.inLabel >= (int)ilm.size())
+        ilm.resize(entry.inLabel + 1, -1);
+    else if (ilm[entry.inLabel] != -1)
+        error("duplicate incoming label %d", entry.inLabel);
 
-        outLabel = lib[i].outLabel;
-        outInterface = lib[i].outInterface;
-        color = lib[i].color;
+    ilm[entry.inLabel] = lib.size();
+    lib.push_back(entry);
+}
+
+const LIBTable::LIBEntry *LIBTable::findLibEntry(int inInterfaceId, int inLabel) const
+{
+    if (inLabel < 0 || inLabel >= (int)ilm.size() || ilm[inLabel] == -1)
+        return NULL;
+
+    const LIBEntry *entry = &lib[ilm[inLabel]];
+    if (inInterfaceId != -1 && entry->inInterfaceId != inInterfaceId)
+        return NULL;
 
-        return true;
+    return entry;
+}
+
+bool LIBTable::resolveLabel(std::string inInterface, int inLabel,
+        LabelOpVector& outLabel, std::string& outInterface, int& color)
+{
+    const LIBEntry *entry;
+    if (inInterface.length() == 0)
+        entry = findLibEntry(-1, inLabel);
+    else
+    {
+        InterfaceEntry *ie = ift->getInterfaceByName(inInterface.c_str());
+        entry = ie ? findLibEntry(ie->getInterfaceId(), inLabel) : NULL;
     }
-    return false;
+    if (!entry)
+        return false;
+
+    outLabel = entry->outLabel;
+    outInterface = entry->outInterface;
+    color = entry->color;
+
+    return true;
 }
 
 int LIBTable::installLibEntry(int inLabel, std::string inInterface, const LabelOpVector& outLabel,
@@ -75,41 +111,43 @@ int LIBTable::installLibEntry(int inLabel, std::string inInterface, const LabelO
         LIBEntry newItem;
         newItem.inLabel = ++maxLabel;
         newItem.inInterface = inInterface;
+        newItem.inInterfaceId = resolveInterfaceId(inInterface);
         newItem.outLabel = outLabel;
         newItem.outInterface = outInterface;
+        newItem.outInterfaceId = resolveInterfaceId(outInterface);
         newItem.color = color;
-        lib.push_back(newItem);
+        addLibEntry(newItem);
         return newItem.inLabel;
     }
     else
     {
-        for (unsigned int i = 0; i < lib.size(); i++)
-        {
-            if (lib[i].inLabel != inLabel)
-                continue;
-
-            lib[i].inInterface = inInterface;
-            lib[i].outLabel = outLabel;
-            lib[i].outInterface = outInterface;
-            lib[i].color = color;
-            return inLabel;
-        }
-        ASSERT(false);
-        return 0; // prevent warning
+        ASSERT(inLabel >= 0 && inLabel < (int)ilm.size() && ilm[inLabel] != -1);
+
+        LIBEntry& entry = lib[ilm[inLabel]];
+        entry.inInterface = inInterface;
+        entry.inInterfaceId = resolveInterfaceId(inInterface);
+        entry.outLabel = outLabel;
+        entry.outInterface = outInterface;
+        entry.outInterfaceId = resolveInterfaceId(outInterface);
+        entry.color = color;
+        return inLabel;
     }
 }
 
 void LIBTable::removeLibEntry(int inLabel)
 {
-    for (unsigned int i = 0; i < lib.size(); i++)
-    {
-        if (lib[i].inLabel != inLabel)
-            continue;
+    ASSERT(inLabel >= 0 && inLabel < (int)ilm.size() && ilm[inLabel] != -1);
 
-        lib.erase(lib.begin() + i);
-        return;
+    // move the last entry into the hole, so that lib stays compact
+    int index = ilm[inLabel];
+    int last = lib.size() - 1;
+    if (index != last)
+    {
+        lib[index] = lib[last];
+        ilm[lib[index].inLabel] = index;
     }
-    ASSERT(false);
+    lib.pop_back();
+    ilm[inLabel] = -1;
 }
 
 void LIBTable::readTableFromXML(const cXMLElement* libtable)
@@ -127,7 +165,9 @@ void LIBTable::readTableFromXML(const cXMLElement* libtable)
         LIBEntry newItem;
         newItem.inLabel = getParameterIntValue(&entry, "inLabel");
         newItem.inInterface = getParameterStrValue(&entry, "inInterface");
+        newItem.inInterfaceId = resolveInterfaceId(newItem.inInterface);
         newItem.outInterface = getParameterStrValue(&entry, "outInterface");
+        newItem.outInterfaceId = resolveInterfaceId(newItem.outInterface);
         newItem.color = getParameterIntValue(&entry, "color", 0);
 
         cXMLElementList ops = getUniqueChild(&entry, "outLabel")->getChildrenByTagName("op");
@@ -164,10 +204,10 @@ void LIBTable::readTableFromXML(const cXMLElement* libtable)
             newItem.outLabel.push_back(l);
         }
 
-        lib.push_back(newItem);
-
         ASSERT(newItem.inLabel > 0);
 
+        addLibEntry(newItem);
+
         if (newItem.inLabel > maxLabel)
             maxLabel = newItem.inLabel;
     }
@@ -25,6 +25,8 @@
 #include "IPv4Address.h"
 #include "IPv4Datagram.h"
 
+class IInterfaceTable;
+
 // label operations
 #define PUSH_OPER              0
 #define SWAP_OPER              1
@@ -42,7 +44,12 @@ struct LabelOp
 typedef std::vector<LabelOp> LabelOpVector;
 
 /**
- * TODO documentation
+ * The label information base of an LSR.
+ *
+ * Labels are allocated from a per-platform label space, so an entry is
+ * identified by its incoming label. The incoming label map (ILM) is a
+ * vector indexed by label, so resolving the label of a forwarded packet
+ * takes constant time; interfaces are matched by interface ID.
  */
 class INET_API LIBTable: public cSimpleModule
 {
@@ -51,9 +58,11 @@ class INET_API LIBTable: public cSimpleModule
         {
             int inLabel;
             std::string inInterface;
+            int inInterfaceId;  // -1 if inInterface is not an interface name
 
             LabelOpVector outLabel;
             std::string outInterface;
+            int outInterfaceId;  // -1 if outInterface is not an interface name
 
             // FIXME colors in nam, temporary solution
             int color;
@@ -63,6 +72,8 @@ class INET_API LIBTable: public cSimpleModule
         IPv4Address routerId;
         int maxLabel;
         std::vector<LIBEntry> lib;
+        std::vector<int> ilm;  // label -> index in lib, or -1
+        IInterfaceTable *ift;
 
     protected:
         virtual void initialize(int stage);
@@ -72,11 +83,24 @@ class INET_API LIBTable: public cSimpleModule
         // static configuration
         virtual void readTableFromXML(const cXMLElement* libtable);
 
+        // incoming label map maintenance
+        virtual int resolveInterfaceId(const std::string& interfaceName);
+        virtual void addLibEntry(const LIBEntry& entry);
+
     public:
         // label management
         virtual bool resolveLabel(std::string inInterface, int inLabel,
                           LabelOpVector& outLabel, std::string& outInterface, int& color);
 
+        /**
+         * Returns the entry for the given incoming label, or NULL if there is
+         * none or it belongs to a different incoming interface. Pass -1 as
+         * inInterfaceId to accept any interface. This is the forwarding fast
+         * path: the returned entry is not copied, and it remains valid until
+         * the table is next modified.
+         */
+        virtual const LIBEntry *findLibEntry(int inInterfaceId, int inLabel) const;
+
         virtual int installLibEntry(int inLabel, std::string inInterface, const LabelOpVector& outLabel,
                             std::string outInterface, int color);
 
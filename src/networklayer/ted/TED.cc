@@ -13,6 +13,7 @@
 //
 
 #include <algorithm>
+#include <functional>
 
 #include "INETDefs.h"
 
@@ -165,43 +166,56 @@ std::ostream & operator<<(std::ostream & os, const TELinkStateInfo& info)
     return os;
 }
 
-// FIXME should this be called findOrCreateVertex() or something like that?
-int TED::assignIndex(std::vector<vertex_t>& vertices, IPv4Address nodeAddr)
+int TED::findOrAddVertex(TEGraph& graph, IPv4Address nodeAddr)
 {
-    // find node in vertices[] whose IPv4 address is nodeAddr
-    for (unsigned int i = 0; i < vertices.size(); i++)
-        if (vertices[i].node == nodeAddr)
-            return i;
+    std::map<IPv4Address, int>::iterator it = graph.nodeIndex.find(nodeAddr);
+    if (it != graph.nodeIndex.end())
+        return it->second;
+
+    int index = graph.nodes.size();
+    graph.nodes.push_back(nodeAddr);
+    graph.outLinks.push_back(std::vector<int>());
+    graph.nodeIndex[nodeAddr] = index;
+    return index;
+}
 
-    // if not found, create
-    vertex_t newVertex;
-    newVertex.node = nodeAddr;
-    newVertex.dist = LS_INFINITY;
-    newVertex.parent = -1;
+void TED::updateGraph(TEGraph& graph, const TELinkStateInfoVector& topology)
+{
+    // links are only ever appended to the TED and never change their
+    // endpoints; start over if that does not hold for this topology
+    unsigned int numLinks = graph.linkDest.size();
+    if (numLinks > topology.size() ||
+        (numLinks > 0 && graph.nodes[graph.linkDest[numLinks - 1]] != topology[numLinks - 1].linkid))
+    {
+        graph = TEGraph();
+        numLinks = 0;
+    }
 
-    vertices.push_back(newVertex);
-    return vertices.size() - 1;
+    for (unsigned int i = numLinks; i < topology.size(); i++)
+    {
+        int src = findOrAddVertex(graph, topology[i].advrouter);
+        int dest = findOrAddVertex(graph, topology[i].linkid);
+        ASSERT(src != dest);
+        graph.outLinks[src].push_back(i);
+        graph.linkDest.push_back(dest);
+    }
 }
 
-IPAddressVector TED::calculateShortestPath(IPAddressVector dest,
-            const TELinkStateInfoVector& topology, double req_bandwidth, int priority)
+IPAddressVector TED::extractPath(const std::vector<vertex_t>& vertices, const IPAddressVector& dest)
 {
-    // FIXME comment: what do we do here?
-    std::vector<vertex_t> V = calculateShortestPaths(topology, req_bandwidth, priority);
-
+    // find the closest reachable vertex among the destinations
     double minDist = LS_INFINITY;
     int minIndex = -1;
 
-    // FIXME comment: what do we do in this block?
-    for (unsigned int i = 0; i < V.size(); i++)
+    for (unsigned int i = 0; i < vertices.size(); i++)
     {
-        if (V[i].dist >= minDist)
+        if (vertices[i].dist >= minDist)
             continue;
 
-        if (find(dest.begin(), dest.end(), V[i].node) == dest.end())
+        if (find(dest.begin(), dest.end(), vertices[i].node) == dest.end())
             continue;
 
-        minDist = V[i].dist;
+        minDist = vertices[i].dist;
         minIndex = i;
     }
 
@@ -210,16 +224,25 @@ IPAddressVector TED::calculateShortestPath(IPAddressVector dest,
     if (minIndex < 0)
         return result;
 
-    result.push_back(V[minIndex].node);
-    while (V[minIndex].parent != -1)
+    // walk back to the root along the parent pointers
+    result.push_back(vertices[minIndex].node);
+    while (vertices[minIndex].parent != -1)
     {
-        minIndex = V[minIndex].parent;
-        result.insert(result.begin(), V[minIndex].node);
+        minIndex = vertices[minIndex].parent;
+        result.push_back(vertices[minIndex].node);
     }
+    std::reverse(result.begin(), result.end());
 
     return result;
 }
 
+IPAddressVector TED::calculateShortestPath(IPAddressVector dest,
+            const TELinkStateInfoVector& topology, double req_bandwidth, int priority)
+{
+    std::vector<vertex_t> V = calculateShortestPaths(topology, req_bandwidth, priority);
+    return extractPath(V, dest);
+}
+
 void TED::rebuildRoutingTable()
 {
     EV << "rebuilding routing table at " << routerId << endl;
@@ -346,58 +369,61 @@ bool TED::isLocalPeer(IPv4Address inetAddr)
 std::vector<TED::vertex_t> TED::calculateShortestPaths(const TELinkStateInfoVector& topology,
             double req_bandwidth, int priority)
 {
-    std::vector<vertex_t> vertices;
-    std::vector<edge_t> edges;
+    // the graph of our own TED is kept between calls, other topologies
+    // get a temporary one
+    TEGraph tempGraph;
+    TEGraph& graph = (&topology == &ted) ? tedGraph : tempGraph;
+    updateGraph(graph, topology);
 
-    // select edges that have enough bandwidth left, and store them into edges[].
-    // meanwhile, collect vertices in vectices[].
-    for (unsigned int i = 0; i < topology.size(); i++)
-    {
-        if (!topology[i].state)
-            continue;
+    int srcIndex = findOrAddVertex(graph, routerId);
 
-        if (topology[i].UnResvBandwidth[priority] < req_bandwidth)
-            continue;
-
-        edge_t edge;
-        edge.src = assignIndex(vertices, topology[i].advrouter);
-        edge.dest = assignIndex(vertices, topology[i].linkid);
-        edge.metric = topology[i].metric;
-        edges.push_back(edge);
+    std::vector<vertex_t> vertices(graph.nodes.size());
+    for (unsigned int i = 0; i < vertices.size(); i++)
+    {
+        vertices[i].node = graph.nodes[i];
+        vertices[i].dist = LS_INFINITY;
+        vertices[i].parent = -1;
     }
-
-    IPv4Address srcAddr = routerId;
-
-    int srcIndex = assignIndex(vertices, srcAddr);
     vertices[srcIndex].dist = 0.0;
 
-    // FIXME comment: Dijkstra? just guessing...
-    for (unsigned int i = 1; i < vertices.size(); i++)
+    // Dijkstra with a binary heap; entries made obsolete by a later
+    // decrease are skipped when popped. Links that are down or do not have
+    // enough unreserved bandwidth at this priority are pruned on the fly.
+    std::greater<std::pair<double, int> > heapCompare;
+    cspfHeap.clear();
+    cspfHeap.push_back(std::make_pair(0.0, srcIndex));
+
+    while (!cspfHeap.empty())
     {
-        bool mod = false;
+        std::pop_heap(cspfHeap.begin(), cspfHeap.end(), heapCompare);
+        double dist = cspfHeap.back().first;
+        int src = cspfHeap.back().second;
+        cspfHeap.pop_back();
 
-        for (unsigned int j = 0; j < edges.size(); j++)
+        if (dist > vertices[src].dist)
+            continue;
+
+        const std::vector<int>& outLinks = graph.outLinks[src];
+        for (unsigned int j = 0; j < outLinks.size(); j++)
         {
-            int src = edges[j].src;
-            int dest = edges[j].dest;
+            const TELinkStateInfo& link = topology[outLinks[j]];
 
-            ASSERT(src >= 0);
-            ASSERT(dest >= 0);
-            ASSERT(src < (int)vertices.size());
-            ASSERT(dest < (int)vertices.size());
-            ASSERT(src != dest);
+            if (!link.state)
+                continue;
 
-            if (vertices[src].dist + edges[j].metric >= vertices[dest].dist)
+            if (link.UnResvBandwidth[priority] < req_bandwidth)
                 continue;
 
-            vertices[dest].dist = vertices[src].dist + edges[j].metric;
+            int dest = graph.linkDest[outLinks[j]];
+            if (dist + link.metric >= vertices[dest].dist)
+                continue;
+
+            vertices[dest].dist = dist + link.metric;
             vertices[dest].parent = src;
 
-            mod = true;
+            cspfHeap.push_back(std::make_pair(vertices[dest].dist, dest));
+            std::push_heap(cspfHeap.begin(), cspfHeap.end(), heapCompare);
         }
-
-        if (!mod)
-            break;
     }
 
     return vertices;
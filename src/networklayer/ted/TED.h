@@ -15,6 +15,8 @@
 #ifndef __INET_TED_H
 #define __INET_TED_H
 
+#include <map>
+
 #include "INETDefs.h"
 
 #include "TED_m.h"
@@ -47,14 +49,19 @@ class TED : public cSimpleModule
     };
 
     /**
-     * Only used internally, during shortest path calculation:
-     * edge in the graph we build from links in TELinkStateInfoVector.
+     * Only used internally, during shortest path calculation: the graph
+     * built from the links in a TELinkStateInfoVector. Vertices are numbered
+     * in order of first appearance, outLinks[v] holds the indices of the
+     * links advertised by vertex v and linkDest[i] the vertex link i points to.
+     * Link state, metric and bandwidth are read from the vector itself,
+     * so the graph only has to be extended when links are added.
      */
-    struct edge_t
+    struct TEGraph
     {
-        int src;       // index into the vertex_t[] vector
-        int dest;      // index into the vertex_t[] vector
-        double metric; // link cost
+        std::vector<IPv4Address> nodes;
+        std::map<IPv4Address, int> nodeIndex;
+        std::vector<std::vector<int> > outLinks;
+        std::vector<int> linkDest;
     };
 
     /**
@@ -101,7 +108,12 @@ class TED : public cSimpleModule
   protected:
     int maxMessageId;
 
-    virtual int assignIndex(std::vector<vertex_t>& vertices, IPv4Address nodeAddr);
+    TEGraph tedGraph;  // graph of ted, extended as links get added
+    std::vector<std::pair<double, int> > cspfHeap;  // reused by calculateShortestPaths()
+
+    int findOrAddVertex(TEGraph& graph, IPv4Address nodeAddr);
+    void updateGraph(TEGraph& graph, const TELinkStateInfoVector& topology);
+    IPAddressVector extractPath(const std::vector<vertex_t>& vertices, const IPAddressVector& dest);
 
     std::vector<vertex_t> calculateShortestPaths(const TELinkStateInfoVector& topology,
         double req_bandwidth, int priority);
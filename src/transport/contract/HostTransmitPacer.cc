@@ -0,0 +1,31 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "HostTransmitPacer.h"
+
+
+Define_Module(HostTransmitPacer);
+
+void HostTransmitPacer::initialize()
+{
+    bucket.initialize(par("pacingRate").doubleValue(), par("pacingBurst").longValue());
+}
+
+void HostTransmitPacer::handleMessage(cMessage *msg)
+{
+    throw cRuntimeError("This module doesn't process messages");
+}
+
@@ -0,0 +1,47 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __INET_HOSTTRANSMITPACER_H
+#define __INET_HOSTTRANSMITPACER_H
+
+
+#include "INETDefs.h"
+
+#include "TransmitPacer.h"
+
+
+/**
+ * Holds the token bucket shared by the TransmitPacer objects of a host.
+ * See the NED file for more info.
+ */
+class INET_API HostTransmitPacer : public cSimpleModule
+{
+  protected:
+    TokenBucket bucket;
+
+  protected:
+    virtual void initialize();
+    virtual void handleMessage(cMessage *msg);
+
+  public:
+    /**
+     * Returns the shared bucket.
+     */
+    TokenBucket *getBucket() {return &bucket;}
+};
+
+#endif
+
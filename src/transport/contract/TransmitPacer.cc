@@ -0,0 +1,153 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <algorithm>   // min
+
+#include "INETDefs.h"
+
+#include "TransmitPacer.h"
+#include "HostTransmitPacer.h"
+#include "ModuleAccess.h"
+
+
+void TokenBucket::initialize(double rateBps, int64 burstSize)
+{
+    if (rateBps < 0)
+        throw cRuntimeError("TokenBucket: invalid rate %g bps", rateBps);
+    if (rateBps > 0 && burstSize <= 0)
+        throw cRuntimeError("TokenBucket: burst size must be positive");
+
+    rate = rateBps / 8;
+    this->burstSize = burstSize;
+    tokens = burstSize;
+    lastUpdate = simTime();
+}
+
+void TokenBucket::refill()
+{
+    simtime_t now = simTime();
+    tokens = std::min(burstSize, tokens + rate * SIMTIME_DBL(now - lastUpdate));
+    lastUpdate = now;
+}
+
+simtime_t TokenBucket::getTimeUntil(double bytes) const
+{
+    return tokens >= bytes ? 0 : (bytes - tokens) / rate;
+}
+
+//---
+
+TransmitPacer::TransmitPacer()
+{
+    owner = NULL;
+    bucket = NULL;
+    queuedBytes = 0;
+    wakeupTimer = NULL;
+}
+
+TransmitPacer::~TransmitPacer()
+{
+    for (ItemQueue::iterator i = queue.begin(); i != queue.end(); ++i)
+        delete i->msg;
+    if (wakeupTimer)
+        owner->cancelAndDelete(wakeupTimer);
+}
+
+void TransmitPacer::initialize(cSimpleModule *owner, double rateBps, int64 burstSize)
+{
+    // the pacers of a host share the bucket of its HostTransmitPacer, if any
+    HostTransmitPacer *hostPacer = dynamic_cast<HostTransmitPacer *>(findModuleWhereverInNode("transmitPacer", owner));
+    if (hostPacer)
+        initialize(owner, hostPacer->getBucket());
+    else
+    {
+        ownBucket.initialize(rateBps, burstSize);
+        initialize(owner, &ownBucket);
+    }
+}
+
+void TransmitPacer::initialize(cSimpleModule *owner, TokenBucket *bucket)
+{
+    this->owner = owner;
+    this->bucket = bucket;
+
+    if (!wakeupTimer)
+        wakeupTimer = new cMessage("pacer");
+}
+
+int64 TransmitPacer::getLength(cMessage *msg)
+{
+    return msg->isPacket() ? ((cPacket *)msg)->getByteLength() : 0;
+}
+
+void TransmitPacer::sendOut(cMessage *msg, cGate *gate)
+{
+    owner->send(msg, gate);
+}
+
+void TransmitPacer::send(cMessage *msg, cGate *gate)
+{
+    if (!isEnabled() && queue.empty())
+    {
+        sendOut(msg, gate);
+        return;
+    }
+
+    Item item;
+    item.msg = msg;
+    item.gate = gate;
+    queue.push_back(item);
+    queuedBytes += getLength(msg);
+
+    // while a wake-up is pending, the message joins the batch it will send
+    if (!wakeupTimer->isScheduled())
+        sendBatch();
+}
+
+bool TransmitPacer::processTimer(cMessage *msg)
+{
+    if (!wakeupTimer || msg != wakeupTimer)
+        return false;
+
+    sendBatch();
+    return true;
+}
+
+void TransmitPacer::sendBatch()
+{
+    bucket->refill();
+
+    // the bucket may be shared: other pacers of the host may have taken
+    // the tokens this wake-up was scheduled for
+    while (!queue.empty())
+    {
+        int64 length = getLength(queue.front().msg);
+        if (length > 0 && isEnabled() && bucket->getTokens() <= 0)
+            break;
+
+        Item item = queue.front();
+        queue.pop_front();
+        queuedBytes -= length;
+        bucket->consume(length);
+        sendOut(item.msg, item.gate);
+    }
+
+    if (!queue.empty())
+    {
+        // wake up when the bucket can release the whole backlog, or a full burst
+        double target = std::min((double)queuedBytes, bucket->getBurstSize());
+        owner->scheduleAt(simTime() + bucket->getTimeUntil(target), wakeupTimer);
+    }
+}
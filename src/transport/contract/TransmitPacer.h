@@ -0,0 +1,174 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef __INET_TRANSMITPACER_H
+#define __INET_TRANSMITPACER_H
+
+
+#include <deque>
+
+#include "INETDefs.h"
+
+
+/**
+ * Token bucket: fills up at the given rate (bytes/s) and holds at most
+ * burstSize bytes. The content may go negative (debt) when a message
+ * longer than the content is let through.
+ *
+ * @see TransmitPacer, HostTransmitPacer
+ */
+class INET_API TokenBucket
+{
+  protected:
+    double rate;            // bytes per second, 0 if disabled
+    double burstSize;       // bucket size in bytes
+    double tokens;          // bucket content in bytes, may be negative
+    simtime_t lastUpdate;   // time of the last refill
+
+  public:
+    TokenBucket() : rate(0), burstSize(0), tokens(0) {}
+
+    /**
+     * Sets the rate (in bit/s; 0 disables pacing) and the bucket size
+     * (in bytes), and fills up the bucket.
+     */
+    void initialize(double rateBps, int64 burstSize);
+
+    /** Adds the tokens accumulated since the last refill */
+    void refill();
+
+    /** Removes the given number of bytes from the bucket */
+    void consume(int64 bytes) {tokens -= bytes;}
+
+    /** Returns the time until the bucket holds the given number of bytes */
+    simtime_t getTimeUntil(double bytes) const;
+
+    double getRate() const {return rate;}
+    double getBurstSize() const {return burstSize;}
+    double getTokens() const {return tokens;}
+};
+
+/**
+ * Token-bucket pacer for messages sent out by a simple module, e.g. the
+ * segments TCP or SCTP hand to IP, or the datagrams of an UDP application.
+ *
+ * A message is sent when it is at the head of the queue and the bucket
+ * is not empty; the bucket may go into debt by the length of the last
+ * message. Messages that cannot be sent are queued (in FIFO order,
+ * together with non-packet messages such as socket commands, which cost
+ * no tokens), and a single wake-up is scheduled for the time when the
+ * bucket can release all of them or a full burst, whichever is smaller.
+ * So a backlog costs one timer event per batch, not one per message.
+ *
+ * If the node contains a HostTransmitPacer module named "transmitPacer",
+ * the pacers of all modules in the node draw from its bucket, so all
+ * flows of the host are paced together; otherwise each pacer has its own
+ * bucket.
+ *
+ * Usage: call initialize() from the owner module's initialize(), send via
+ * send() instead of cSimpleModule::send(), and pass self-messages to
+ * processTimer() first in handleMessage(). With a zero rate, send() sends
+ * immediately.
+ *
+ * <pre>
+ *   pacer.initialize(this, par("pacingRate"), par("pacingBurst"));
+ *   ...
+ *   pacer.send(pk, gate("out"));
+ *   ...
+ *   void X::handleMessage(cMessage *msg)
+ *   {
+ *       if (pacer.processTimer(msg))
+ *           return;
+ *       ...
+ * </pre>
+ */
+class INET_API TransmitPacer
+{
+  protected:
+    struct Item
+    {
+        cMessage *msg;
+        cGate *gate;
+    };
+    typedef std::deque<Item> ItemQueue;
+
+    cSimpleModule *owner;
+    TokenBucket ownBucket;  // used if the node has no HostTransmitPacer
+    TokenBucket *bucket;    // ownBucket or the bucket of the HostTransmitPacer
+    ItemQueue queue;
+    int64 queuedBytes;
+    cMessage *wakeupTimer;
+
+  protected:
+    void sendBatch();
+    static int64 getLength(cMessage *msg);
+
+    /** Sends the message on the gate of the owner module */
+    virtual void sendOut(cMessage *msg, cGate *gate);
+
+  public:
+    /**
+     * Constructor. The pacer is disabled until initialize() is called.
+     */
+    TransmitPacer();
+
+    /**
+     * Destructor. Deletes the queued messages and the timer.
+     */
+    virtual ~TransmitPacer();
+
+    /**
+     * Sets the owner module. Uses the bucket of the node's HostTransmitPacer
+     * if there is one, otherwise an own bucket with the given rate (in bit/s;
+     * 0 disables pacing) and bucket size (in bytes).
+     */
+    void initialize(cSimpleModule *owner, double rateBps, int64 burstSize);
+
+    /**
+     * Sets the owner module and the bucket to draw from, which may be
+     * shared with other pacers.
+     */
+    void initialize(cSimpleModule *owner, TokenBucket *bucket);
+
+    /**
+     * Whether pacing is enabled (nonzero rate).
+     */
+    bool isEnabled() const {return bucket && bucket->getRate() > 0;}
+
+    /**
+     * Sends the message on the given gate of the owner module, either now
+     * or later when the bucket allows it.
+     */
+    void send(cMessage *msg, cGate *gate);
+
+    /**
+     * Must be called with the self-messages of the owner module. Returns
+     * true (and sends the next batch) if msg was the pacer's wake-up timer.
+     */
+    bool processTimer(cMessage *msg);
+
+    /**
+     * Returns the number of queued messages.
+     */
+    int getQueueLength() const {return queue.size();}
+
+    /**
+     * Returns the number of queued bytes.
+     */
+    int64 getQueuedBytes() const {return queuedBytes;}
+};
+
+#endif
@@ -19,6 +19,7 @@
 #include "InterfaceTableAccess.h"
 #include "UDPSocket.h"
 #include "UDPControlInfo.h"
+#include "TransmitPacer.h"
 #ifdef WITH_IPv4
 #include "IPv4InterfaceData.h"
 #endif
@@ -29,6 +30,7 @@ UDPSocket::UDPSocket()
     // automatically assigned ones.
     sockId = generateSocketId();
     gateToUdp = NULL;
+    pacer = NULL;
 }
 
 int UDPSocket::generateSocketId()
@@ -41,7 +43,10 @@ void UDPSocket::sendToUDP(cMessage *msg)
     if (!gateToUdp)
         throw cRuntimeError("UDPSocket: setOutputGate() must be invoked before socket can be used");
 
-    check_and_cast<cSimpleModule *>(gateToUdp->getOwnerModule())->send(msg, gateToUdp);
+    if (pacer)
+        pacer->send(msg, gateToUdp);
+    else
+        check_and_cast<cSimpleModule *>(gateToUdp->getOwnerModule())->send(msg, gateToUdp);
 }
 
 void UDPSocket::bind(int localPort)
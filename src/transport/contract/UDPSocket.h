@@ -23,6 +23,7 @@
 #include "IPvXAddress.h"
 
 class UDPDataIndication;
+class TransmitPacer;
 
 /**
  * UDPSocket is a convenience class, to make it easier to send and receive
@@ -62,6 +63,7 @@ class INET_API UDPSocket
   protected:
     int sockId;
     cGate *gateToUdp;
+    TransmitPacer *pacer;
 
   protected:
     void sendToUDP(cMessage *msg);
@@ -97,6 +99,13 @@ class INET_API UDPSocket
      */
     void setOutputGate(cGate *toUdp)  {gateToUdp = toUdp;}
 
+    /**
+     * Makes the socket send everything (datagrams and commands, in order)
+     * through the given pacer, which must have been initialized with the
+     * owner module of the output gate. Pass NULL to send directly again.
+     */
+    void setPacer(TransmitPacer *pacer)  {this->pacer = pacer;}
+
     /**
      * Bind the socket to a local port number. Use port=0 for ephemeral port.
      */
@@ -86,6 +86,7 @@ void SCTP::bindPortForUDP()
     EV << "Binding to UDP port " << SCTP_UDP_PORT << endl;
 
     udpSocket.setOutputGate(gate("to_ip"));
+    udpSocket.setPacer(&pacer);
     udpSocket.bind(SCTP_UDP_PORT);
 }
 
@@ -107,6 +108,7 @@ void SCTP::initialize()
     numPacketsReceived = 0;
     numPacketsDropped = 0;
     sizeConnMap = 0;
+    pacer.initialize(this, par("pacingRate").doubleValue(), par("pacingBurst").longValue());
     if ((bool)par("udpEncapsEnabled"))
         bindPortForUDP();
 }
@@ -142,7 +144,11 @@ void SCTP::handleMessage(cMessage *msg)
 
     sctpEV3<<"\n\nSCTPMain handleMessage at "<<getFullPath()<<"\n";
 
-    if (msg->isSelfMessage())
+    if (pacer.processTimer(msg))
+    {
+        sctpEV3<<"pacer sent next batch\n";
+    }
+    else if (msg->isSelfMessage())
     {
 
         sctpEV3<<"selfMessage\n";
@@ -29,6 +29,7 @@
 
 #include "IPvXAddress.h"
 #include "UDPSocket.h"
+#include "TransmitPacer.h"
 
 #define SCTP_UDP_PORT  9899
 
@@ -169,6 +170,7 @@ class INET_API SCTP : public cSimpleModule
         std::list<SCTPAssociation*>assocList;
 
         UDPSocket udpSocket;
+        TransmitPacer pacer;
 
     protected:
         int32 sizeConnMap;
@@ -223,6 +223,10 @@ class INET_API SCTPPathVariables : public cObject
         uint32              partialBytesAcked;
         uint32              queuedBytes;                            // T.D. 19.02.2010
         uint32              outstandingBytes;
+        // ====== Queue Counters ==============================================
+        uint32              roomTransQ;         // bytes queued for this path in transmissionQ (incl. header and padding)
+        uint32              bookedTransQ;       // booked bytes queued for this path in transmissionQ
+        uint32              roomRetransQ;       // bytes outstanding on this path in retransmissionQ
         // ~~~~~~ Temporary storage for SACK handling ~~~~~~~
         uint32              outstandingBytesBeforeUpdate;   // T.D. 20.10.2009
         uint32              newlyAckedBytes;                        // T.D. 20.10.2009
@@ -424,7 +428,7 @@ class INET_API SCTPStateVariables : public cObject
         uint32                      numGaps;
         uint32                      gapStartList[MAX_GAP_COUNT];
         uint32                      gapStopList[MAX_GAP_COUNT];
-        uint64                      outstandingBytes;     // Number of bytes outstanding
+        uint64                      outstandingBytes;     // Number of bytes outstanding, sum over all paths
         uint64                      queuedReceivedBytes;  // Number of bytes in receiver queue
         uint32                      lastStreamScheduled;
         uint32                      assocPmtu;                // smallest overall path mtu
@@ -486,15 +490,11 @@ class INET_API SCTPAssociation : public cObject
 
     // map for storing the path parameters
     typedef std::map<IPvXAddress,SCTPPathVariables*> SCTPPathMap;
-    // map for storing the queued bytes per path
-    typedef std::map<IPvXAddress, uint32> CounterMap;
+    // the queued bytes per path are kept in SCTPPathVariables
     typedef struct counter {
         uint64    roomSumSendStreams;
         uint64    bookedSumSendStreams;
         uint64    roomSumRcvStreams;
-        CounterMap roomTransQ;
-        CounterMap bookedTransQ;
-        CounterMap roomRetransQ;
     } QueueCounter;
     typedef struct calcBytesToSend {
         bool chunk;
@@ -62,6 +62,9 @@ SCTPPathVariables::SCTPPathVariables(const IPvXAddress& addr, SCTPAssociation* a
     partialBytesAcked = 0;
     queuedBytes = 0;
     outstandingBytes = 0;
+    roomTransQ = 0;
+    bookedTransQ = 0;
+    roomRetransQ = 0;
 
     RoutingTableAccess routingTableAccess;
     const InterfaceEntry* rtie = routingTableAccess.get()->getInterfaceForDestAddr(remoteAddress.get4());
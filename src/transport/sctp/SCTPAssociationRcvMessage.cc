@@ -49,8 +49,7 @@ void SCTPAssociation::decreaseOutstandingBytes(SCTPDataVariables* chunk)
 
     chunk->countsAsOutstanding = false;
 
-    CounterMap::iterator iterator = qCounter.roomRetransQ.find(lastPath->remoteAddress);
-        iterator->second -= ADD_PADDING(chunk->booksize + SCTP_DATA_CHUNK_LENGTH);
+    lastPath->roomRetransQ -= ADD_PADDING(chunk->booksize + SCTP_DATA_CHUNK_LENGTH);
 
 }
 
@@ -373,9 +372,6 @@ bool SCTPAssociation::processInitArrived(SCTPInitChunk* initchunk, int32 srcPort
                 sctpEV3<<__LINE__<<" get new path for "<<remoteAddr<<"\n";
                 SCTPPathVariables* rPath = new SCTPPathVariables(remoteAddr, this);
                 sctpPathMap[rPath->remoteAddress] = rPath;
-                qCounter.roomTransQ[rPath->remoteAddress] = 0;
-                qCounter.bookedTransQ[rPath->remoteAddress] = 0;
-                qCounter.roomRetransQ[rPath->remoteAddress] = 0;
             }
             initPeerTsn = initchunk->getInitTSN();
             state->cTsnAck = initPeerTsn - 1;
@@ -437,9 +433,6 @@ bool SCTPAssociation::processInitArrived(SCTPInitChunk* initchunk, int32 srcPort
                         this->remoteAddressList.push_back(initchunk->getAddresses(j));
                     }
                     sctpPathMap[path->remoteAddress] = path;
-                    qCounter.roomTransQ[path->remoteAddress] = 0;
-                    qCounter.bookedTransQ[path->remoteAddress] = 0;
-                    qCounter.roomRetransQ[path->remoteAddress] = 0;
                 }
             }
             SCTPPathMap::iterator ite = sctpPathMap.find(remoteAddr);
@@ -448,9 +441,6 @@ bool SCTPAssociation::processInitArrived(SCTPInitChunk* initchunk, int32 srcPort
                 SCTPPathVariables* path = new SCTPPathVariables(remoteAddr, this);
                 sctpEV3<<__LINE__<<" get new path for "<<remoteAddr<<" ptr="<<path<<"\n";
                 sctpPathMap[remoteAddr] = path;
-                qCounter.roomTransQ[remoteAddr] = 0;
-                qCounter.bookedTransQ[remoteAddr] = 0;
-                qCounter.roomRetransQ[remoteAddr] = 0;
             }
             trans = performStateTransition(SCTP_E_RCV_INIT);
             if (trans) {
@@ -549,9 +539,6 @@ bool SCTPAssociation::processInitAckArrived(SCTPInitAckChunk* initAckChunk)
                 sctpEV3<<__LINE__<<" get new path for "<<remoteAddr<<"\n";
                 SCTPPathVariables* path = new SCTPPathVariables(remoteAddr, this);
                 sctpPathMap[remoteAddr] = path;
-                qCounter.roomTransQ[remoteAddr] = 0;
-                qCounter.roomRetransQ[remoteAddr] = 0;
-                qCounter.bookedTransQ[remoteAddr] = 0;
             }
             inboundStreams = ((initAckChunk->getNoOutStreams()<inboundStreams)?initAckChunk->getNoOutStreams():inboundStreams);
             outboundStreams = ((initAckChunk->getNoInStreams()<outboundStreams)?initAckChunk->getNoInStreams():outboundStreams);
@@ -696,10 +683,8 @@ void SCTPAssociation::tsnWasReneged(SCTPDataVariables*       chunk,
                 else {
                     chunk->enqueuedInTransmissionQ = true;
                     chunk->setNextDestination(chunk->getLastDestinationPath());
-                    CounterMap::iterator q = qCounter.roomTransQ.find(chunk->getNextDestination());
-                    q->second += ADD_PADDING(chunk->len/8+SCTP_DATA_CHUNK_LENGTH);
-                    CounterMap::iterator qb = qCounter.bookedTransQ.find(chunk->getNextDestination());
-                    qb->second += chunk->booksize;
+                    chunk->getNextDestinationPath()->roomTransQ += ADD_PADDING(chunk->len/8+SCTP_DATA_CHUNK_LENGTH);
+                    chunk->getNextDestinationPath()->bookedTransQ += chunk->booksize;
                     return;
                 }
             }
@@ -994,7 +979,7 @@ SCTPEventCode SCTPAssociation::processSackArrived(SCTPSackChunk* sackChunk)
 
         if (myPath->outstandingBytes == 0) {
             // T.D. 07.01.2010: Only stop T3 timer when there is nothing more to send on this path!
-            if (qCounter.roomTransQ.find(myPath->remoteAddress)->second == 0) {
+            if (myPath->roomTransQ == 0) {
                 // Stop T3 timer, if there are no more outstanding bytes.
                 stopTimer(myPath->T3_RtxTimer);
             }
@@ -1060,10 +1045,8 @@ void SCTPAssociation::handleChunkReportedAsAcked(uint32&                  highes
             sctpEV3 << "Found TSN " << myChunk->tsn << " in transmissionQ -> remote it" << endl;
             transmissionQ->removeMsg(myChunk->tsn);
             myChunk->enqueuedInTransmissionQ = false;
-            CounterMap::iterator q = qCounter.roomTransQ.find(myChunk->getNextDestination());
-            q->second -= ADD_PADDING(myChunk->len/8+SCTP_DATA_CHUNK_LENGTH);
-            CounterMap::iterator qb = qCounter.bookedTransQ.find(myChunk->getNextDestination());
-            qb->second -= myChunk->booksize;
+            myChunk->getNextDestinationPath()->roomTransQ -= ADD_PADDING(myChunk->len/8+SCTP_DATA_CHUNK_LENGTH);
+            myChunk->getNextDestinationPath()->bookedTransQ -= myChunk->booksize;
         }
         myChunk->gapReports = 0;
     }
@@ -1130,10 +1113,8 @@ void SCTPAssociation::handleChunkReportedAsMissing(const SCTPSackChunk*      sac
                         }
                         else    {
                             myChunk->enqueuedInTransmissionQ = true;
-                            CounterMap::iterator q = qCounter.roomTransQ.find(myChunk->getNextDestination());
-                            q->second += ADD_PADDING(myChunk->len/8+SCTP_DATA_CHUNK_LENGTH);
-                            CounterMap::iterator qb = qCounter.bookedTransQ.find(myChunk->getNextDestination());
-                            qb->second += myChunk->booksize;
+                            myChunk->getNextDestinationPath()->roomTransQ += ADD_PADDING(myChunk->len/8+SCTP_DATA_CHUNK_LENGTH);
+                            myChunk->getNextDestinationPath()->bookedTransQ += myChunk->booksize;
                         }
                         myChunkNextPath->requiresRtx = true;
                         if (myChunkNextPath->findLowestTSN == true) {
@@ -1184,13 +1165,12 @@ uint32 SCTPAssociation::dequeueAckedChunks(const uint32       tsna,
             if (transmissionQ->getChunk(chunk->tsn)) {
                 transmissionQ->removeMsg(chunk->tsn);
                 chunk->enqueuedInTransmissionQ = false;
-                CounterMap::iterator q = qCounter.roomTransQ.find(chunk->getNextDestination());
-                q->second -= ADD_PADDING(chunk->len/8+SCTP_DATA_CHUNK_LENGTH);
-                CounterMap::iterator qb = qCounter.bookedTransQ.find(chunk->getNextDestination());
-                qb->second -= chunk->booksize;
+                chunk->getNextDestinationPath()->roomTransQ -= ADD_PADDING(chunk->len/8+SCTP_DATA_CHUNK_LENGTH);
+                chunk->getNextDestinationPath()->bookedTransQ -= chunk->booksize;
             }
 
-            chunk = retransmissionQ->getAndExtractChunk(chunk->tsn);
+            // the chunk is the first one in the queue, no need to look it up again
+            retransmissionQ->payloadQueue.erase(iterator);
             state->sendBuffer -= chunk->len/8;
 
             SCTPPathVariables* lastPath = chunk->getLastDestinationPath();
@@ -1741,10 +1721,8 @@ void SCTPAssociation::moveChunkToOtherPath(SCTPDataVariables* chunk,
     else {
         chunk->enqueuedInTransmissionQ = true;
         sctpEV3 << "Inserting TSN " << chunk->tsn << " into transmissionQ" << endl;
-        CounterMap::iterator q = qCounter.roomTransQ.find(chunk->getNextDestination());
-        q->second += ADD_PADDING(chunk->len/8+SCTP_DATA_CHUNK_LENGTH);
-        CounterMap::iterator qb = qCounter.bookedTransQ.find(chunk->getNextDestination());
-        qb->second += chunk->booksize;
+        chunk->getNextDestinationPath()->roomTransQ += ADD_PADDING(chunk->len/8+SCTP_DATA_CHUNK_LENGTH);
+        chunk->getNextDestinationPath()->bookedTransQ += chunk->booksize;
 
         if (chunk->countsAsOutstanding) {
             decreaseOutstandingBytes(chunk);
@@ -31,8 +31,7 @@ void SCTPAssociation::increaseOutstandingBytes(SCTPDataVariables* chunk,
     path->outstandingBytes += chunk->booksize;
     state->outstandingBytes += chunk->booksize;
 
-    CounterMap::iterator iterator = qCounter.roomRetransQ.find(path->remoteAddress);
-        iterator->second += ADD_PADDING(chunk->booksize + SCTP_DATA_CHUNK_LENGTH);
+    path->roomRetransQ += ADD_PADDING(chunk->booksize + SCTP_DATA_CHUNK_LENGTH);
 }
 
 int32 SCTPAssociation::calculateBytesToSendOnPath(const SCTPPathVariables* pathVar)
@@ -76,6 +75,7 @@ void SCTPAssociation::storePacket(SCTPPathVariables* pathVar,
               << pathVar->outstandingBytes - state->packetBytes << endl;
     assert(pathVar->outstandingBytes >= state->packetBytes);
     pathVar->outstandingBytes -= state->packetBytes;
+    state->outstandingBytes -= state->packetBytes;
         qCounter.roomSumSendStreams += state->packetBytes + (dataChunksAdded * SCTP_DATA_CHUNK_LENGTH);
     qCounter.bookedSumSendStreams += state->packetBytes;
 
@@ -94,6 +94,7 @@ void SCTPAssociation::loadPacket(SCTPPathVariables* pathVar,
     *packetBytes = state->packetBytes;
     sctpEV3 << "loadPacket: path=" << pathVar->remoteAddress << " osb=" << pathVar->outstandingBytes << " -> " << pathVar->outstandingBytes + state->packetBytes << endl;
     pathVar->outstandingBytes += state->packetBytes;
+    state->outstandingBytes += state->packetBytes;
     qCounter.bookedSumSendStreams -= state->packetBytes;
 
     for (uint16 i = 0; i < (*sctpMsg)->getChunksArraySize(); i++)
@@ -162,9 +163,8 @@ SCTPPathVariables* SCTPAssociation::choosePathForRetransmission()
 
     for (SCTPPathMap::iterator iterator = sctpPathMap.begin(); iterator != sctpPathMap.end(); ++iterator) {
         SCTPPathVariables*          path = iterator->second;
-        CounterMap::const_iterator tq = qCounter.roomTransQ.find(path->remoteAddress);
-        if ((tq != qCounter.roomTransQ.end()) && (tq->second > max)) {
-            max = tq->second;
+        if (path->roomTransQ > max) {
+            max = path->roomTransQ;
             temp = path;
         }
     }
@@ -240,9 +240,8 @@ void SCTPAssociation::bytesAllowedToSend(SCTPPathVariables* path,
 
     // ====== Retransmissions ================================================
     else {
-        CounterMap::const_iterator it = qCounter.roomTransQ.find(path->remoteAddress);
-        sctpEV3 << "bytesAllowedToSend(" << path->remoteAddress << "): bytes in transQ=" << it->second << endl;
-        if (it->second > 0) {
+        sctpEV3 << "bytesAllowedToSend(" << path->remoteAddress << "): bytes in transQ=" << path->roomTransQ << endl;
+        if (path->roomTransQ > 0) {
             const int32 allowance = path->cwnd - path->outstandingBytes;
             sctpEV3 << "bytesAllowedToSend(" << path->remoteAddress << "): cwnd-osb=" << allowance << endl;
             if (state->peerRwnd < path->pmtu) {
@@ -251,14 +250,13 @@ void SCTPAssociation::bytesAllowedToSend(SCTPPathVariables* path,
                 return;
             }
             else if (allowance > 0) {
-                CounterMap::const_iterator bit = qCounter.bookedTransQ.find(path->remoteAddress);
-                if (bit->second > (uint32)allowance) {
+                if (path->bookedTransQ > (uint32)allowance) {
                     bytes.bytesToSend = allowance;
                     sctpEV3 << "bytesAllowedToSend(" << path->remoteAddress << "): cwnd does not allow all RTX" << endl;
                     return;  // More bytes available than allowed -> just return what is allowed.
                 }
                 else {
-                    bytes.bytesToSend = bit->second;
+                    bytes.bytesToSend = path->bookedTransQ;
                     sctpEV3 << "bytesAllowedToSend(" << path->remoteAddress << "): cwnd allows more than those "
                                  << bytes.bytesToSend << " bytes for retransmission" << endl;
                 }
@@ -354,8 +352,7 @@ void SCTPAssociation::sendOnPath(SCTPPathVariables* pathId, bool firstPass)
 
         outstandingBytes = path->outstandingBytes;
         assert((int32)outstandingBytes >= 0);
-        CounterMap::iterator tq = qCounter.roomTransQ.find(path->remoteAddress);
-        tcount = tq->second;
+        tcount = path->roomTransQ;
         scount = qCounter.roomSumSendStreams;     // includes header and padding
         sctpEV3 << "\nsendAll: on " << path->remoteAddress << ":"
                   << " tcount="      << tcount
@@ -709,6 +706,7 @@ void SCTPAssociation::sendOnPath(SCTPPathVariables* pathId, bool firstPass)
                         {
                             state->sctpMsg = NULL;
                             path->outstandingBytes += packetBytes;
+                            state->outstandingBytes += packetBytes;
                             packetBytes = 0;
                         }
                         headerCreated = false;
@@ -254,7 +254,7 @@ void SCTPAssociation::sendToIP(SCTPMessage*       sctpmsg,
             controlInfo->setSrcAddr(IPv6Address());
             controlInfo->setDestAddr(dest.get6());
             sctpmsg->setControlInfo(controlInfo);
-            sctpMain->send(sctpmsg, "to_ipv6");
+            sctpMain->pacer.send(sctpmsg, sctpMain->gate("to_ipv6"));
         }
         else {
             IPv4ControlInfo* controlInfo = new IPv4ControlInfo();
@@ -262,7 +262,7 @@ void SCTPAssociation::sendToIP(SCTPMessage*       sctpmsg,
             controlInfo->setSrcAddr(IPv4Address("0.0.0.0"));
             controlInfo->setDestAddr(dest.get4());
             sctpmsg->setControlInfo(controlInfo);
-            sctpMain->send(sctpmsg, "to_ip");
+            sctpMain->pacer.send(sctpmsg, sctpMain->gate("to_ip"));
         }
         recordInPathVectors(sctpmsg, dest);
     }
@@ -461,9 +461,6 @@ void SCTPAssociation::sendInit()
             sctpEV3<<__LINE__<<" get new path for "<<(*it)<<"\n";
             SCTPPathVariables* path = new SCTPPathVariables((*it), this);
             sctpPathMap[(*it)] = path;
-            qCounter.roomTransQ[(*it)] = 0;
-            qCounter.bookedTransQ[(*it)] = 0;
-            qCounter.roomRetransQ[(*it)] = 0;
         }
     }
     else
@@ -471,9 +468,6 @@ void SCTPAssociation::sendInit()
         sctpEV3<<__LINE__<<" get new path for "<<remoteAddr<<"\n";
         SCTPPathVariables* path = new SCTPPathVariables(remoteAddr, this);
         sctpPathMap[remoteAddr] = path;
-        qCounter.roomTransQ[remoteAddr] = 0;
-        qCounter.bookedTransQ[remoteAddr] = 0;
-        qCounter.roomRetransQ[remoteAddr] = 0;
     }
     // send it
     state->initChunk = check_and_cast<SCTPInitChunk *>(initChunk->dup());
@@ -1176,9 +1170,6 @@ void SCTPAssociation::addPath(const IPvXAddress& addr)
         sctpEV3<<__LINE__<<" get new path for "<<addr<<"\n";
         SCTPPathVariables* path = new SCTPPathVariables(addr, this);
         sctpPathMap[addr] = path;
-        qCounter.roomTransQ[addr] = 0;
-        qCounter.bookedTransQ[addr] = 0;
-        qCounter.roomRetransQ[addr] = 0;
     }
     sctpEV3<<"path added\n";
 }
@@ -1591,10 +1582,8 @@ SCTPDataVariables* SCTPAssociation::getOutboundDataChunk(const SCTPPathVariables
                     //                        "if" statement above!
                     transmissionQ->payloadQueue.erase(it);
                     chunk->enqueuedInTransmissionQ = false;
-                    CounterMap::iterator i = qCounter.roomTransQ.find(path->remoteAddress);
-                    i->second -= ADD_PADDING(chunk->len/8+SCTP_DATA_CHUNK_LENGTH);
-                    CounterMap::iterator ib = qCounter.bookedTransQ.find(path->remoteAddress);
-                    ib->second -= chunk->booksize;
+                    chunk->getNextDestinationPath()->roomTransQ -= ADD_PADDING(chunk->len/8+SCTP_DATA_CHUNK_LENGTH);
+                    chunk->getNextDestinationPath()->bookedTransQ -= chunk->booksize;
                     return chunk;
                 }
             }
@@ -1993,6 +1982,7 @@ void SCTPAssociation::pmStartPathManagement()
 
 
         path->partialBytesAcked = 0;
+        state->outstandingBytes -= path->outstandingBytes;
         path->outstandingBytes = 0;
         path->activePath = true;
         // Timer probably not running, but stop it anyway I.R.
@@ -2015,11 +2005,8 @@ void SCTPAssociation::pmStartPathManagement()
 
 int32 SCTPAssociation::getOutstandingBytes() const
 {
-    int32 osb = 0;
-    for (SCTPPathMap::const_iterator pm = sctpPathMap.begin(); pm != sctpPathMap.end(); pm++) {
-        osb += pm->second->outstandingBytes;
-    }
-    return osb;
+    // state->outstandingBytes is kept equal to the sum of the paths' outstandingBytes
+    return (int32)state->outstandingBytes;
 }
 
 void SCTPAssociation::pmClearPathCounter(SCTPPathVariables* path)
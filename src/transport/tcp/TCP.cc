@@ -23,6 +23,7 @@
 #include "TCPConnection.h"
 #include "TCPSegment.h"
 #include "TCPCommand_m.h"
+#include "ECN_m.h"
 
 #ifdef WITH_IPv4
 #include "ICMPMessage_m.h"
@@ -89,6 +90,8 @@ void TCP::initialize()
 
     recordStatistics = par("recordStats");
 
+    pacer.initialize(this, par("pacingRate").doubleValue(), par("pacingBurst").longValue());
+
     cModule *netw = simulation.getSystemModule();
     testing = netw->hasPar("testing") && netw->par("testing").boolValue();
     logverbose = !testing && netw->hasPar("logverbose") && netw->par("logverbose").boolValue();
@@ -106,7 +109,11 @@ TCP::~TCP()
 
 void TCP::handleMessage(cMessage *msg)
 {
-    if (msg->isSelfMessage())
+    if (pacer.processTimer(msg))
+    {
+        // the pacer has sent the next batch of segments
+    }
+    else if (msg->isSelfMessage())
     {
         TCPConnection *conn = (TCPConnection *) msg->getContextPointer();
         bool ret = conn->processTimer(msg);
@@ -132,14 +139,16 @@ void TCP::handleMessage(cMessage *msg)
             // must be a TCPSegment
             TCPSegment *tcpseg = check_and_cast<TCPSegment *>(msg);
 
-            // get src/dest addresses
+            // get src/dest addresses and the ECN field
             IPvXAddress srcAddr, destAddr;
+            int ecn = IP_ECN_NOT_ECT;
 
             if (dynamic_cast<IPv4ControlInfo *>(tcpseg->getControlInfo()) != NULL)
             {
                 IPv4ControlInfo *controlInfo = (IPv4ControlInfo *)tcpseg->removeControlInfo();
                 srcAddr = controlInfo->getSrcAddr();
                 destAddr = controlInfo->getDestAddr();
+                ecn = controlInfo->getExplicitCongestionNotification();
                 delete controlInfo;
             }
             else if (dynamic_cast<IPv6ControlInfo *>(tcpseg->getControlInfo()) != NULL)
@@ -147,6 +156,7 @@ void TCP::handleMessage(cMessage *msg)
                 IPv6ControlInfo *controlInfo = (IPv6ControlInfo *)tcpseg->removeControlInfo();
                 srcAddr = controlInfo->getSrcAddr();
                 destAddr = controlInfo->getDestAddr();
+                ecn = controlInfo->getExplicitCongestionNotification();
                 delete controlInfo;
             }
             else
@@ -158,6 +168,14 @@ void TCP::handleMessage(cMessage *msg)
             TCPConnection *conn = findConnForSegment(tcpseg, srcAddr, destAddr);
             if (conn)
             {
+                if (ecn == IP_ECN_CE)
+                {
+                    // echo the CE mark with ECE in the next ACK, and send that ACK
+                    // without delay so that the sender can react within one RTT
+                    conn->getState()->ecn_ce_rcvd = true;
+                    conn->getState()->ack_now = true;
+                }
+
                 bool ret = conn->processTCPSegment(tcpseg, srcAddr, destAddr);
                 if (!ret)
                     removeConnection(conn);
@@ -26,6 +26,7 @@
 
 #include "IPvXAddress.h"
 #include "TCPCommand_m.h"
+#include "TransmitPacer.h"
 
 // Forward declarations:
 class TCPConnection;
@@ -163,6 +164,8 @@ class INET_API TCP : public cSimpleModule
 
     bool recordStatistics;  // output vectors on/off
 
+    TransmitPacer pacer;    // paces segments sent to IP (disabled if pacingRate is 0)
+
   public:
     TCP() {}
     virtual ~TCP();
@@ -249,6 +249,11 @@ class INET_API TCPStateVariables : public cObject
     uint32 sackedBytes_old;  // old number of sackedBytes - needed for RFC 3042 to check if last dupAck contained new sack information
     bool lossRecovery;       // indicates if algorithm is in loss recovery phase
 
+    // ECN related variables (RFC 3168)
+    bool ecn_enabled;        // set if data segments are sent as ECN-capable (ECT(0)); set by the TCPAlgorithm (e.g. TCPDCTCP)
+    bool ecn_ce_rcvd;        // set if a CE-marked segment was received since the last ACK was sent: the next ACK carries ECE
+    bool ecn_echo_rcvd;      // set if the ACK currently being processed carries ECE
+
     // those counters would logically belong to TCPAlgorithm, but it's a lot easier to manage them here
     uint32 dupacks;          // current number of received consecutive duplicate ACKs
     uint32 snd_sacks;        // number of sent sacks
@@ -101,6 +101,10 @@ TCPStateVariables::TCPStateVariables()
     sackedBytes_old = 0;
     lossRecovery = false;
 
+    ecn_enabled = false;
+    ecn_ce_rcvd = false;
+    ecn_echo_rcvd = false;
+
     dupacks = 0;
     snd_sacks = 0;
     rcv_sacks = 0;
@@ -157,6 +161,7 @@ std::string TCPStateVariables::detailedInfo() const
     out << "snd_sack_perm=" << snd_sack_perm << "\n";
     out << "snd_sacks=" << snd_sacks << "\n";
     out << "rcv_sacks=" << rcv_sacks << "\n";
+    out << "ecn_enabled=" << ecn_enabled << "\n";
     out << "dupacks=" << dupacks << "\n";
     out << "rcv_oooseg=" << rcv_oooseg << "\n";
     out << "rcv_naseg=" << rcv_naseg << "\n";
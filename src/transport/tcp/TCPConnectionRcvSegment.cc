@@ -1164,6 +1164,9 @@ bool TCPConnection::processAckInEstabEtc(TCPSegment *tcpseg)
 {
     tcpEV2 << "Processing ACK in a data transfer state\n";
 
+    // remember ECN-Echo for the TCPAlgorithm (e.g. TCPDCTCP)
+    state->ecn_echo_rcvd = tcpseg->getEceBit();
+
     //
     //"
     //  If SND.UNA < SEG.ACK =< SND.NXT then, set SND.UNA <- SEG.ACK.
@@ -27,6 +27,7 @@
 #include "TCPCommand_m.h"
 #include "IPv4ControlInfo.h"
 #include "IPv6ControlInfo.h"
+#include "ECN_m.h"
 #include "TCPSendQueue.h"
 #include "TCPSACKRexmitQueue.h"
 #include "TCPReceiveQueue.h"
@@ -157,6 +158,8 @@ void TCPConnection::printSegmentBrief(TCPSegment *tcpseg)
 
     if (tcpseg->getUrgBit())  tcpEV << "urg " << tcpseg->getUrgentPointer() << " ";
 
+    if (tcpseg->getEceBit())  tcpEV << "ece ";
+
     if (tcpseg->getHeaderLength() > TCP_HEADER_OCTETS) // Header options present? TCP_HEADER_OCTETS = 20
     {
         tcpEV << "options ";
@@ -216,6 +219,14 @@ void TCPConnection::sendToIP(TCPSegment *tcpseg)
     if (sndAckVector)
         sndAckVector->record(tcpseg->getAckNo());
 
+    // ECN (RFC 3168): echo a received CE mark, and send data as ECN-capable
+    if (state->ecn_ce_rcvd && tcpseg->getAckBit())
+    {
+        tcpseg->setEceBit(true);
+        state->ecn_ce_rcvd = false;
+    }
+    int ecn = (state->ecn_enabled && tcpseg->getPayloadLength() != 0) ? IP_ECN_ECT_0 : IP_ECN_NOT_ECT;
+
     // final touches on the segment before sending
     tcpseg->setSrcPort(localPort);
     tcpseg->setDestPort(remotePort);
@@ -236,9 +247,10 @@ void TCPConnection::sendToIP(TCPSegment *tcpseg)
         controlInfo->setProtocol(IP_PROT_TCP);
         controlInfo->setSrcAddr(localAddr.get4());
         controlInfo->setDestAddr(remoteAddr.get4());
+        controlInfo->setExplicitCongestionNotification(ecn);
         tcpseg->setControlInfo(controlInfo);
 
-        tcpMain->send(tcpseg, "ipOut");
+        tcpMain->pacer.send(tcpseg, tcpMain->gate("ipOut"));
     }
     else
     {
@@ -247,9 +259,10 @@ void TCPConnection::sendToIP(TCPSegment *tcpseg)
         controlInfo->setProtocol(IP_PROT_TCP);
         controlInfo->setSrcAddr(localAddr.get6());
         controlInfo->setDestAddr(remoteAddr.get6());
+        controlInfo->setExplicitCongestionNotification(ecn);
         tcpseg->setControlInfo(controlInfo);
 
-        tcpMain->send(tcpseg, "ipv6Out");
+        tcpMain->pacer.send(tcpseg, tcpMain->gate("ipv6Out"));
     }
 }
 
@@ -258,6 +271,8 @@ void TCPConnection::sendToIP(TCPSegment *tcpseg, IPvXAddress src, IPvXAddress de
     tcpEV << "Sending: ";
     printSegmentBrief(tcpseg);
 
+    TCP *tcpMain = check_and_cast<TCP *>(simulation.getContextModule());
+
     if (!dest.isIPv6())
     {
         // send over IPv4
@@ -267,7 +282,7 @@ void TCPConnection::sendToIP(TCPSegment *tcpseg, IPvXAddress src, IPvXAddress de
         controlInfo->setDestAddr(dest.get4());
         tcpseg->setControlInfo(controlInfo);
 
-        check_and_cast<TCP *>(simulation.getContextModule())->send(tcpseg, "ipOut");
+        tcpMain->pacer.send(tcpseg, tcpMain->gate("ipOut"));
     }
     else
     {
@@ -278,7 +293,7 @@ void TCPConnection::sendToIP(TCPSegment *tcpseg, IPvXAddress src, IPvXAddress de
         controlInfo->setDestAddr(dest.get6());
         tcpseg->setControlInfo(controlInfo);
 
-        check_and_cast<TCP *>(simulation.getContextModule())->send(tcpseg, "ipv6Out");
+        tcpMain->pacer.send(tcpseg, tcpMain->gate("ipv6Out"));
     }
 }
 
@@ -0,0 +1,336 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <algorithm>   // min,max
+#include "TCPBBR.h"
+#include "TCP.h"
+
+
+Register_Class(TCPBBR);
+
+#define BBR_HIGH_GAIN       2.885  // 2/ln(2), gain of STARTUP
+#define BBR_CWND_GAIN       2.0    // cwnd gain in PROBE_BW
+#define BBR_RTPROP_WINDOW   10     // lifetime of the rt_prop estimate, in seconds
+#define BBR_PACING_QUANTUM  0.001  // data sent per pacing timer event, in seconds at the pacing rate
+#define BBR_MAX_QUANTUM     65536  // upper limit of the send quantum, in bytes
+
+static const double pacingGainCycle[] = {1.25, 0.75, 1, 1, 1, 1, 1, 1};
+#define BBR_CYCLE_LENGTH    (int)(sizeof(pacingGainCycle) / sizeof(pacingGainCycle[0]))
+
+
+TCPBBRStateVariables::TCPBBRStateVariables()
+{
+    bbr_mode = STARTUP;
+    btl_bw = 0;
+    for (int i = 0; i < BBR_BW_WINDOW; i++)
+        bw_samples[i] = 0;
+    rt_prop = 0;
+    rt_prop_stamp = 0;
+    pacing_gain = BBR_HIGH_GAIN;
+    cwnd_gain = BBR_HIGH_GAIN;
+    pacing_rate = 0;
+
+    delivered = 0;
+    round_count = 0;
+    round_end = 0;
+    round_start_delivered = 0;
+    round_start_time = 0;
+
+    full_bw = 0;
+    full_bw_count = 0;
+    cycle_index = 0;
+    cycle_stamp = 0;
+}
+
+std::string TCPBBRStateVariables::info() const
+{
+    std::stringstream out;
+    out << TCPNewRenoStateVariables::info();
+    out << " btl_bw=" << btl_bw;
+    out << " rt_prop=" << rt_prop;
+    return out.str();
+}
+
+std::string TCPBBRStateVariables::detailedInfo() const
+{
+    static const char *modeNames[] = {"STARTUP", "DRAIN", "PROBE_BW"};
+
+    std::stringstream out;
+    out << TCPNewRenoStateVariables::detailedInfo();
+    out << "bbr_mode=" << modeNames[bbr_mode] << "\n";
+    out << "btl_bw=" << btl_bw << "\n";
+    out << "rt_prop=" << rt_prop << "\n";
+    out << "pacing_gain=" << pacing_gain << "\n";
+    out << "cwnd_gain=" << cwnd_gain << "\n";
+    out << "pacing_rate=" << pacing_rate << "\n";
+    out << "delivered=" << delivered << "\n";
+    out << "round_count=" << round_count << "\n";
+    out << "cycle_index=" << cycle_index << "\n";
+    return out.str();
+}
+
+//---
+
+TCPBBR::TCPBBR() : TCPNewReno(),
+  state((TCPBBRStateVariables *&)TCPAlgorithm::state)
+{
+    pacingTimer = NULL;
+    btlBwVector = pacingRateVector = NULL;
+}
+
+TCPBBR::~TCPBBR()
+{
+    if (pacingTimer)
+        delete cancelEvent(pacingTimer);
+
+    delete btlBwVector;
+    delete pacingRateVector;
+}
+
+void TCPBBR::initialize()
+{
+    TCPNewReno::initialize();
+
+    pacingTimer = new cMessage("PACING");
+    pacingTimer->setContextPointer(conn);
+
+    if (conn->getTcpMain()->recordStatistics)
+    {
+        btlBwVector = new cOutVector("BBR btl_bw");
+        pacingRateVector = new cOutVector("BBR pacing rate");
+    }
+}
+
+void TCPBBR::established(bool active)
+{
+    state->round_end = state->snd_max;
+    state->round_start_time = simTime();
+
+    TCPNewReno::established(active);
+}
+
+void TCPBBR::connectionClosed()
+{
+    TCPNewReno::connectionClosed();
+
+    cancelEvent(pacingTimer);
+}
+
+void TCPBBR::processTimer(cMessage *timer, TCPEventCode& event)
+{
+    if (timer == pacingTimer)
+        processPacingTimer(event);
+    else
+        TCPNewReno::processTimer(timer, event);
+}
+
+void TCPBBR::processPacingTimer(TCPEventCode& event)
+{
+    sendData(false);
+}
+
+void TCPBBR::recalculateSlowStartThreshold()
+{
+    // BBR does not treat loss as a congestion signal: NewReno's recovery then
+    // keeps about the current flight size in the network (packet conservation),
+    // and increaseCongestionWindow() restores the model-based cwnd afterwards
+    uint32 flight_size = state->snd_max - state->snd_una;
+    state->ssthresh = std::max(flight_size, 4 * state->snd_mss);
+
+    if (ssthreshVector)
+        ssthreshVector->record(state->ssthresh);
+}
+
+void TCPBBR::rttMeasurementComplete(simtime_t tSent, simtime_t tAcked)
+{
+    TCPNewReno::rttMeasurementComplete(tSent, tAcked);
+
+    // rt_prop is a windowed minimum of the RTT
+    simtime_t rtt = tAcked - tSent;
+    simtime_t now = simTime();
+
+    if (state->rt_prop == 0 || rtt <= state->rt_prop || now - state->rt_prop_stamp > BBR_RTPROP_WINDOW)
+    {
+        state->rt_prop = rtt;
+        state->rt_prop_stamp = now;
+    }
+}
+
+void TCPBBR::receivedDataAck(uint32 firstSeqAcked)
+{
+    updateModel(state->snd_una - firstSeqAcked);
+
+    TCPNewReno::receivedDataAck(firstSeqAcked);
+}
+
+void TCPBBR::updateModel(uint32 bytesAcked)
+{
+    simtime_t now = simTime();
+
+    state->delivered += bytesAcked;
+
+    if (seqGE(state->snd_una, state->round_end))
+    {
+        // end of a round trip: take a delivery rate sample, and update the
+        // max filter (slots of rounds older than BBR_BW_WINDOW get overwritten)
+        simtime_t interval = now - state->round_start_time;
+
+        if (interval > 0)
+        {
+            double sample = (state->delivered - state->round_start_delivered) / SIMTIME_DBL(interval);
+            state->bw_samples[state->round_count % BBR_BW_WINDOW] = sample;
+            state->btl_bw = *std::max_element(state->bw_samples, state->bw_samples + BBR_BW_WINDOW);
+
+            if (btlBwVector)
+                btlBwVector->record(state->btl_bw);
+        }
+
+        state->round_count++;
+        state->round_end = state->snd_max;
+        state->round_start_delivered = state->delivered;
+        state->round_start_time = now;
+
+        if (state->bbr_mode == TCPBBRStateVariables::STARTUP)
+        {
+            // the pipe is full when btl_bw grew less than 25% in three rounds
+            if (state->btl_bw >= state->full_bw * 1.25)
+            {
+                state->full_bw = state->btl_bw;
+                state->full_bw_count = 0;
+            }
+            else if (++state->full_bw_count >= 3)
+            {
+                state->bbr_mode = TCPBBRStateVariables::DRAIN;
+                tcpEV << "BBR: bottleneck bandwidth reached (" << state->btl_bw << " bytes/s), entering DRAIN\n";
+            }
+        }
+    }
+
+    if (state->bbr_mode == TCPBBRStateVariables::DRAIN)
+    {
+        // drain the queue built up in STARTUP
+        uint32 bdp = (uint32)(state->btl_bw * SIMTIME_DBL(state->rt_prop));
+
+        if (state->snd_max - state->snd_una <= bdp)
+        {
+            state->bbr_mode = TCPBBRStateVariables::PROBE_BW;
+            state->cycle_index = 0;
+            state->cycle_stamp = now;
+            tcpEV << "BBR: queue drained, entering PROBE_BW\n";
+        }
+    }
+    else if (state->bbr_mode == TCPBBRStateVariables::PROBE_BW)
+    {
+        // move to the next phase of the gain cycle after each rt_prop
+        if (now - state->cycle_stamp > state->rt_prop)
+        {
+            state->cycle_index = (state->cycle_index + 1) % BBR_CYCLE_LENGTH;
+            state->cycle_stamp = now;
+        }
+    }
+
+    updatePacingRate();
+}
+
+void TCPBBR::updatePacingRate()
+{
+    switch (state->bbr_mode)
+    {
+        case TCPBBRStateVariables::STARTUP:
+            state->pacing_gain = BBR_HIGH_GAIN;
+            state->cwnd_gain = BBR_HIGH_GAIN;
+            break;
+
+        case TCPBBRStateVariables::DRAIN:
+            state->pacing_gain = 1 / BBR_HIGH_GAIN;
+            state->cwnd_gain = BBR_HIGH_GAIN;
+            break;
+
+        case TCPBBRStateVariables::PROBE_BW:
+            state->pacing_gain = pacingGainCycle[state->cycle_index];
+            state->cwnd_gain = BBR_CWND_GAIN;
+            break;
+    }
+
+    // until the first bandwidth sample, pace at the rate of cwnd per SRTT
+    if (state->btl_bw > 0)
+        state->pacing_rate = state->pacing_gain * state->btl_bw;
+    else if (state->srtt > 0)
+        state->pacing_rate = state->pacing_gain * state->snd_cwnd / SIMTIME_DBL(state->srtt);
+
+    if (pacingRateVector)
+        pacingRateVector->record(state->pacing_rate);
+}
+
+void TCPBBR::increaseCongestionWindow(uint32 firstSeqAcked)
+{
+    uint32 bytesAcked = state->snd_una - firstSeqAcked;
+    uint32 target = std::max((uint32)(state->cwnd_gain * state->btl_bw * SIMTIME_DBL(state->rt_prop)), 4 * state->snd_mss);
+
+    // grow by the acked bytes in STARTUP, and towards cwnd_gain * BDP afterwards
+    if (state->bbr_mode != TCPBBRStateVariables::STARTUP)
+        state->snd_cwnd = std::min(state->snd_cwnd + bytesAcked, target);
+    else if (state->snd_cwnd < target || state->btl_bw == 0)
+        state->snd_cwnd += bytesAcked;
+
+    if (cwndVector)
+        cwndVector->record(state->snd_cwnd);
+
+    tcpEV << "BBR: target cwnd=" << target << ", cwnd=" << state->snd_cwnd
+          << ", pacing rate=" << state->pacing_rate << " bytes/s\n";
+}
+
+bool TCPBBR::sendData(bool sendCommandInvoked)
+{
+    if (pacingTimer->isScheduled())
+    {
+        tcpEV << "Pacing: the previous send quantum is still being paced out, not sending now\n";
+        return false;
+    }
+
+    // Nagle's algorithm, as in TCPBaseAlg::sendData()
+    bool fullSegmentsOnly = sendCommandInvoked && state->nagle_enabled && state->snd_una != state->snd_max;
+
+    // as in TCPBaseAlg::sendData(), do not send a full cwnd after an idle period
+    restartIdleConnection();
+
+    // TCPConnection::sendData() starts from snd_max unless after RTO
+    uint32 old_snd_nxt = state->afterRto ? state->snd_nxt : state->snd_max;
+    uint32 window = state->snd_cwnd;
+
+    // allow at most one send quantum above the data in flight
+    if (state->pacing_rate > 0)
+        window = std::min(window, old_snd_nxt - state->snd_una + getSendQuantum());
+
+    if (!conn->sendData(fullSegmentsOnly, window))
+        return false;
+
+    // one timer event for the whole quantum
+    if (state->pacing_rate > 0)
+        conn->scheduleTimeout(pacingTimer, getPacingInterval(state->snd_nxt - old_snd_nxt));
+
+    return true;
+}
+
+uint32 TCPBBR::getSendQuantum() const
+{
+    uint32 quantum = (uint32)std::min(state->pacing_rate * BBR_PACING_QUANTUM, (double)BBR_MAX_QUANTUM);
+    return std::max(quantum, 2 * state->snd_mss);
+}
+
+simtime_t TCPBBR::getPacingInterval(uint32 bytesSent) const
+{
+    return bytesSent / state->pacing_rate;
+}
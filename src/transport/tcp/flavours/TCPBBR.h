@@ -0,0 +1,140 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __INET_TCPBBR_H
+#define __INET_TCPBBR_H
+
+#include "INETDefs.h"
+
+#include "TCPNewReno.h"
+
+#define BBR_BW_WINDOW  10  // length of the bottleneck bandwidth max filter, in rounds
+
+/**
+ * State variables for TCPBBR.
+ */
+class INET_API TCPBBRStateVariables : public TCPNewRenoStateVariables
+{
+  public:
+    TCPBBRStateVariables();
+    virtual std::string info() const;
+    virtual std::string detailedInfo() const;
+
+    enum Mode { STARTUP, DRAIN, PROBE_BW };
+
+    Mode bbr_mode;             ///< current state of the BBR state machine
+    double btl_bw;             ///< bottleneck bandwidth estimate (bytes/s), max of bw_samples
+    double bw_samples[BBR_BW_WINDOW]; ///< delivery rate of the last rounds (bytes/s)
+    simtime_t rt_prop;         ///< round-trip propagation time estimate (0 if none yet)
+    simtime_t rt_prop_stamp;   ///< time when rt_prop was measured
+    double pacing_gain;        ///< pacing rate = pacing_gain * btl_bw
+    double cwnd_gain;          ///< cwnd = cwnd_gain * btl_bw * rt_prop
+    double pacing_rate;        ///< current pacing rate (bytes/s), 0 if not paced yet
+
+    uint32 delivered;          ///< bytes acknowledged so far
+    uint32 round_count;        ///< number of round trips so far
+    uint32 round_end;          ///< the current round ends when snd_una passes this
+    uint32 round_start_delivered; ///< value of delivered at the start of the round
+    simtime_t round_start_time;   ///< start time of the round
+
+    double full_bw;            ///< btl_bw at the last significant growth in STARTUP
+    uint32 full_bw_count;      ///< rounds without significant btl_bw growth
+    int cycle_index;           ///< current phase of the PROBE_BW gain cycle
+    simtime_t cycle_stamp;     ///< start time of the current phase
+};
+
+
+/**
+ * A simplified model of BBR congestion control (BBR v1, as described by
+ * Cardwell et al., "BBR: Congestion-Based Congestion Control", ACM Queue 2016).
+ *
+ * The sender estimates the bottleneck bandwidth (maximum of the per-round
+ * delivery rates over the last BBR_BW_WINDOW rounds) and the round-trip
+ * propagation time (minimum RTT over 10 seconds), and sets the pacing rate
+ * and cwnd from them. It goes through the STARTUP, DRAIN and PROBE_BW
+ * states; PROBE_RTT is not modelled. Loss recovery is NewReno's, but losses
+ * do not reduce the model: ssthresh is kept at the flight size.
+ *
+ * Pacing: sendData() passes a window of at most one send quantum (about
+ * 1ms worth of data at the pacing rate, but at least 2 SMSS) above the data
+ * in flight to TCPConnection::sendData(), and then schedules a single
+ * pacing timer for when that quantum has drained at the pacing rate.
+ * While the timer is pending, ACKs do not trigger transmissions. This
+ * costs one timer event per quantum instead of one per segment.
+ */
+class INET_API TCPBBR : public TCPNewReno
+{
+  protected:
+    TCPBBRStateVariables *&state; // alias to TCPAlgorithm's 'state'
+
+    cMessage *pacingTimer;
+
+    cOutVector *btlBwVector;      // will record btl_bw
+    cOutVector *pacingRateVector; // will record pacing_rate
+
+    /** Create and return a TCPBBRStateVariables object. */
+    virtual TCPStateVariables *createStateVariables() {
+        return new TCPBBRStateVariables();
+    }
+
+    /** Losses are not congestion signals for BBR: keep ssthresh at the flight size */
+    virtual void recalculateSlowStartThreshold();
+
+    /** Model-based cwnd: cwnd_gain * BDP */
+    virtual void increaseCongestionWindow(uint32 firstSeqAcked);
+
+    /** Updates rt_prop as well */
+    virtual void rttMeasurementComplete(simtime_t tSent, simtime_t tAcked);
+
+    /** Paced send: at most one send quantum per pacing timer period */
+    virtual bool sendData(bool sendCommandInvoked);
+
+    /** Returns the send quantum: about 1ms of data at the pacing rate, at least 2 SMSS */
+    virtual uint32 getSendQuantum() const;
+
+    /** Returns the time needed to send the given number of bytes at the pacing rate */
+    virtual simtime_t getPacingInterval(uint32 bytesSent) const;
+
+    /** Sends the next quantum */
+    virtual void processPacingTimer(TCPEventCode& event);
+
+    /** Updates btl_bw at the end of each round, and the state machine */
+    virtual void updateModel(uint32 bytesAcked);
+
+    /** Sets the gains for the current mode and recomputes pacing_rate */
+    virtual void updatePacingRate();
+
+  public:
+    /** Ctor */
+    TCPBBR();
+
+    /** Virtual dtor */
+    virtual ~TCPBBR();
+
+    /** Creates the pacing timer */
+    virtual void initialize();
+
+    virtual void established(bool active);
+
+    virtual void connectionClosed();
+
+    /** Process the pacing timer as well */
+    virtual void processTimer(cMessage *timer, TCPEventCode& event);
+
+    /** Redefine what should happen when data got acked, to update the model */
+    virtual void receivedDataAck(uint32 firstSeqAcked);
+};
+
+#endif
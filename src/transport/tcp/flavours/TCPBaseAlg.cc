@@ -442,6 +442,17 @@ bool TCPBaseAlg::sendData(bool sendCommandInvoked)
     if (fullSegmentsOnly)
         tcpEV << "Nagle is enabled and there's unacked data: only full segments will be sent\n";
 
+    restartIdleConnection();
+
+    //
+    // Send window is effectively the minimum of the congestion window (cwnd)
+    // and the advertised window (snd_wnd).
+    //
+    return conn->sendData(fullSegmentsOnly, state->snd_cwnd);
+}
+
+void TCPBaseAlg::restartIdleConnection()
+{
     // RFC 2581, pages 7 and 8: "When TCP has not received a segment for
     // more than one retransmission timeout, cwnd is reduced to the value
     // of the restart window (RW) before transmission begins.
@@ -467,12 +478,6 @@ bool TCPBaseAlg::sendData(bool sendCommandInvoked)
             tcpEV << "Restarting idle connection, CWND is set to " << state->snd_cwnd << "\n";
         }
     }
-
-    //
-    // Send window is effectively the minimum of the congestion window (cwnd)
-    // and the advertised window (snd_wnd).
-    //
-    return conn->sendData(fullSegmentsOnly, state->snd_cwnd);
 }
 
 void TCPBaseAlg::sendCommandInvoked()
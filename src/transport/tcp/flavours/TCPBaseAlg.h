@@ -150,6 +150,12 @@ class INET_API TCPBaseAlg : public TCPAlgorithm
      */
     virtual bool sendData(bool sendCommandInvoked);
 
+    /**
+     * Reduces cwnd to the restart window if there is data to send but none
+     * was sent for more than one retransmission timeout (RFC 2581, RFC 5681)
+     */
+    virtual void restartIdleConnection();
+
     /** Utility function */
     cMessage *cancelEvent(cMessage *msg) {return conn->getTcpMain()->cancelEvent(msg);}
 
@@ -0,0 +1,155 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <math.h>
+#include <algorithm>   // min,max
+#include "TCPCubic.h"
+#include "TCP.h"
+
+
+Register_Class(TCPCubic);
+
+// RFC 8312 constants
+#define CUBIC_C     0.4  // scaling constant of the cubic function, in segments/s^3
+#define CUBIC_BETA  0.7  // multiplicative decrease factor
+
+
+TCPCubicStateVariables::TCPCubicStateVariables()
+{
+    w_max = 0;
+    w_last_max = 0;
+    epoch_start = 0;
+    k = 0;
+    origin_point = 0;
+    w_est = 0;
+}
+
+std::string TCPCubicStateVariables::info() const
+{
+    std::stringstream out;
+    out << TCPNewRenoStateVariables::info();
+    out << " w_max=" << w_max;
+    return out.str();
+}
+
+std::string TCPCubicStateVariables::detailedInfo() const
+{
+    std::stringstream out;
+    out << TCPNewRenoStateVariables::detailedInfo();
+    out << "w_max=" << w_max << "\n";
+    out << "w_last_max=" << w_last_max << "\n";
+    out << "epoch_start=" << epoch_start << "\n";
+    out << "k=" << k << "\n";
+    out << "origin_point=" << origin_point << "\n";
+    out << "w_est=" << w_est << "\n";
+    return out.str();
+}
+
+//---
+
+TCPCubic::TCPCubic() : TCPNewReno(),
+  state((TCPCubicStateVariables *&)TCPAlgorithm::state)
+{
+}
+
+void TCPCubic::recalculateSlowStartThreshold()
+{
+    // RFC 8312, 4.6: "Fast Convergence": if the flow has lost bandwidth since
+    // the previous congestion event, release more of it by lowering W_max
+    if (state->snd_cwnd < state->w_last_max)
+    {
+        state->w_last_max = state->snd_cwnd;
+        state->w_max = (uint32)(state->snd_cwnd * (1.0 + CUBIC_BETA) / 2.0);
+    }
+    else
+    {
+        state->w_last_max = state->snd_cwnd;
+        state->w_max = state->snd_cwnd;
+    }
+
+    // RFC 8312, 4.5: "Multiplicative Decrease": ssthresh = cwnd * beta_cubic
+    state->ssthresh = std::max((uint32)(state->snd_cwnd * CUBIC_BETA), 2 * state->snd_mss);
+
+    // a new congestion avoidance epoch starts with the next ACK after recovery
+    state->epoch_start = 0;
+
+    tcpEV << "CUBIC: W_max=" << state->w_max << ", ssthresh=" << state->ssthresh << "\n";
+
+    if (ssthreshVector)
+        ssthreshVector->record(state->ssthresh);
+}
+
+void TCPCubic::increaseCongestionWindow(uint32 firstSeqAcked)
+{
+    if (state->snd_cwnd < state->ssthresh)
+    {
+        // Slow Start is the same as NewReno's
+        TCPNewReno::increaseCongestionWindow(firstSeqAcked);
+        return;
+    }
+
+    uint32 mss = state->snd_mss;
+    simtime_t now = simTime();
+
+    if (state->epoch_start == 0)
+    {
+        // first ACK of a new congestion avoidance epoch: place the plateau
+        // of the cubic function at W_max (RFC 8312, 4.1)
+        state->epoch_start = now;
+
+        if (state->snd_cwnd < state->w_max)
+        {
+            state->k = pow((double)(state->w_max - state->snd_cwnd) / mss / CUBIC_C, 1.0 / 3.0);
+            state->origin_point = state->w_max;
+        }
+        else
+        {
+            state->k = 0;
+            state->origin_point = state->snd_cwnd;
+        }
+        state->w_est = state->snd_cwnd;
+    }
+
+    // RFC 8312, 4.1: the target is W_cubic(t + RTT), limited to 1.5 * cwnd
+    double t = SIMTIME_DBL(now - state->epoch_start + state->srtt) - state->k;
+    double target = state->origin_point + CUBIC_C * t * t * t * mss;
+    target = std::min(target, 1.5 * state->snd_cwnd);
+
+    // RFC 8312, 4.3 and 4.4: concave and convex regions
+    uint32 incr;
+    if (target > state->snd_cwnd)
+        incr = (uint32)((target - state->snd_cwnd) * mss / state->snd_cwnd);
+    else
+        incr = mss * mss / (100 * state->snd_cwnd);  // hardly grow above the plateau (as in Linux)
+
+    if (incr == 0)
+        incr = 1;
+
+    state->snd_cwnd += incr;
+
+    // RFC 8312, 4.2: "TCP-Friendly Region": never be slower than Reno with the
+    // same average window, i.e. additive increase of 3*(1-beta)/(1+beta) SMSS per RTT
+    uint32 bytesAcked = state->snd_una - firstSeqAcked;
+    state->w_est += 3.0 * (1.0 - CUBIC_BETA) / (1.0 + CUBIC_BETA) * bytesAcked * mss / state->snd_cwnd;
+
+    if (state->w_est > state->snd_cwnd)
+        state->snd_cwnd = (uint32)state->w_est;
+
+    if (cwndVector)
+        cwndVector->record(state->snd_cwnd);
+
+    tcpEV << "cwnd > ssthresh: CUBIC Congestion Avoidance: target=" << (uint32)target
+          << ", W_est=" << (uint32)state->w_est << ", cwnd=" << state->snd_cwnd << "\n";
+}
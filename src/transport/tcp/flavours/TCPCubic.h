@@ -0,0 +1,74 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __INET_TCPCUBIC_H
+#define __INET_TCPCUBIC_H
+
+#include "INETDefs.h"
+
+#include "TCPNewReno.h"
+
+
+/**
+ * State variables for TCPCubic.
+ */
+class INET_API TCPCubicStateVariables : public TCPNewRenoStateVariables
+{
+  public:
+    TCPCubicStateVariables();
+    virtual std::string info() const;
+    virtual std::string detailedInfo() const;
+
+    uint32 w_max;            ///< cwnd before the last window reduction (W_max)
+    uint32 w_last_max;       ///< W_max before the last reduction, for fast convergence
+    simtime_t epoch_start;   ///< start of the current congestion avoidance epoch (0 if none)
+    double k;                ///< time (s) the cubic function needs to reach origin_point
+    uint32 origin_point;     ///< window (bytes) at the plateau of the cubic function
+    double w_est;            ///< estimated window of a Reno flow (TCP-friendly region), in bytes
+};
+
+
+/**
+ * Implements CUBIC congestion control (RFC 8312) on top of TCPNewReno.
+ *
+ * Outside Fast Recovery the congestion window follows
+ * W(t) = C*(t-K)^3 + W_max (in segments and seconds), but never grows
+ * slower than a standard Reno flow would (TCP-friendly region). On
+ * congestion the window is reduced by beta = 0.7, and W_max is lowered
+ * further (fast convergence) when the flow lost bandwidth since the
+ * previous congestion event. Slow start and loss recovery are NewReno's.
+ */
+class INET_API TCPCubic : public TCPNewReno
+{
+  protected:
+    TCPCubicStateVariables *&state; // alias to TCPAlgorithm's 'state'
+
+    /** Create and return a TCPCubicStateVariables object. */
+    virtual TCPStateVariables *createStateVariables() {
+        return new TCPCubicStateVariables();
+    }
+
+    /** Multiplicative decrease with beta = 0.7, and W_max bookkeeping */
+    virtual void recalculateSlowStartThreshold();
+
+    /** Cubic window growth in congestion avoidance */
+    virtual void increaseCongestionWindow(uint32 firstSeqAcked);
+
+  public:
+    /** Ctor */
+    TCPCubic();
+};
+
+#endif
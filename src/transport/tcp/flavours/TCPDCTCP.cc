@@ -0,0 +1,134 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <algorithm>   // min,max
+#include "TCPDCTCP.h"
+#include "TCP.h"
+
+
+Register_Class(TCPDCTCP);
+
+#define DCTCP_G  (1.0 / 16)  // weight of new samples in alpha (RFC 8257, 4.2)
+
+
+TCPDCTCPStateVariables::TCPDCTCPStateVariables()
+{
+    dctcp_alpha = 1.0;  // RFC 8257, 4.2: start conservatively
+    dctcp_windowEnd = 0;
+    dctcp_bytesAcked = 0;
+    dctcp_bytesMarked = 0;
+    dctcp_cwrSeq = 0;
+}
+
+std::string TCPDCTCPStateVariables::info() const
+{
+    std::stringstream out;
+    out << TCPNewRenoStateVariables::info();
+    out << " dctcp_alpha=" << dctcp_alpha;
+    return out.str();
+}
+
+std::string TCPDCTCPStateVariables::detailedInfo() const
+{
+    std::stringstream out;
+    out << TCPNewRenoStateVariables::detailedInfo();
+    out << "dctcp_alpha=" << dctcp_alpha << "\n";
+    out << "dctcp_windowEnd=" << dctcp_windowEnd << "\n";
+    out << "dctcp_bytesAcked=" << dctcp_bytesAcked << "\n";
+    out << "dctcp_bytesMarked=" << dctcp_bytesMarked << "\n";
+    out << "dctcp_cwrSeq=" << dctcp_cwrSeq << "\n";
+    return out.str();
+}
+
+//---
+
+TCPDCTCP::TCPDCTCP() : TCPNewReno(),
+  state((TCPDCTCPStateVariables *&)TCPAlgorithm::state)
+{
+    alphaVector = NULL;
+}
+
+TCPDCTCP::~TCPDCTCP()
+{
+    delete alphaVector;
+}
+
+void TCPDCTCP::initialize()
+{
+    TCPNewReno::initialize();
+
+    state->ecn_enabled = true;
+
+    if (conn->getTcpMain()->recordStatistics)
+        alphaVector = new cOutVector("DCTCP alpha");
+}
+
+void TCPDCTCP::established(bool active)
+{
+    TCPNewReno::established(active);
+
+    state->dctcp_windowEnd = state->snd_max;
+    state->dctcp_cwrSeq = state->snd_una;
+}
+
+void TCPDCTCP::receivedDataAck(uint32 firstSeqAcked)
+{
+    processEcnFeedback(firstSeqAcked);
+
+    TCPNewReno::receivedDataAck(firstSeqAcked);
+}
+
+void TCPDCTCP::processEcnFeedback(uint32 firstSeqAcked)
+{
+    uint32 bytesAcked = state->snd_una - firstSeqAcked;
+
+    // RFC 8257, 3.3: count acknowledged and CE-marked bytes
+    state->dctcp_bytesAcked += bytesAcked;
+    if (state->ecn_echo_rcvd)
+        state->dctcp_bytesMarked += bytesAcked;
+
+    // RFC 8257, 3.3: at the end of the observation window update alpha:
+    // alpha = (1 - g) * alpha + g * F
+    if (seqGE(state->snd_una, state->dctcp_windowEnd))
+    {
+        double f = state->dctcp_bytesAcked ? (double)state->dctcp_bytesMarked / state->dctcp_bytesAcked : 0.0;
+        state->dctcp_alpha = (1.0 - DCTCP_G) * state->dctcp_alpha + DCTCP_G * f;
+        state->dctcp_windowEnd = state->snd_max;
+        state->dctcp_bytesAcked = 0;
+        state->dctcp_bytesMarked = 0;
+
+        tcpEV << "DCTCP: F=" << f << ", alpha=" << state->dctcp_alpha << "\n";
+
+        if (alphaVector)
+            alphaVector->record(state->dctcp_alpha);
+    }
+
+    // RFC 8257, 3.3: on ECE reduce cwnd once per window by alpha/2:
+    // cwnd = cwnd * (1 - alpha / 2)
+    if (state->ecn_echo_rcvd && !state->lossRecovery && seqGE(state->snd_una, state->dctcp_cwrSeq))
+    {
+        state->ssthresh = std::max((uint32)(state->snd_cwnd * (1.0 - state->dctcp_alpha / 2)), 2 * state->snd_mss);
+        state->snd_cwnd = state->ssthresh;
+        state->dctcp_cwrSeq = state->snd_max;
+
+        tcpEV << "DCTCP: ECN-Echo received, reducing cwnd to " << state->snd_cwnd << "\n";
+
+        if (ssthreshVector)
+            ssthreshVector->record(state->ssthresh);
+
+        if (cwndVector)
+            cwndVector->record(state->snd_cwnd);
+    }
+}
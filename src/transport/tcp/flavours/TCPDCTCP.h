@@ -0,0 +1,86 @@
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __INET_TCPDCTCP_H
+#define __INET_TCPDCTCP_H
+
+#include "INETDefs.h"
+
+#include "TCPNewReno.h"
+
+
+/**
+ * State variables for TCPDCTCP.
+ */
+class INET_API TCPDCTCPStateVariables : public TCPNewRenoStateVariables
+{
+  public:
+    TCPDCTCPStateVariables();
+    virtual std::string info() const;
+    virtual std::string detailedInfo() const;
+
+    double dctcp_alpha;        ///< estimated fraction of CE-marked bytes
+    uint32 dctcp_windowEnd;    ///< end of the current observation window (about one RTT)
+    uint32 dctcp_bytesAcked;   ///< bytes acknowledged in the current observation window
+    uint32 dctcp_bytesMarked;  ///< bytes acknowledged with ECE in the current observation window
+    uint32 dctcp_cwrSeq;       ///< cwnd is reduced at most once until snd_una passes this
+};
+
+
+/**
+ * Implements DCTCP (RFC 8257) on top of TCPNewReno.
+ *
+ * Data segments are sent ECN-capable. The receiver echoes every CE mark
+ * with ECE in an immediate ACK (see TCP and TCPConnection), and the sender
+ * keeps a moving average (alpha) of the fraction of acknowledged bytes
+ * that were marked. Once per window it reduces cwnd by alpha/2 when ECE
+ * was seen. Packet losses are handled as in NewReno.
+ *
+ * The bottleneck queues must mark with a step threshold, e.g. DropTailQueue
+ * with its ecnMarkingThreshold parameter.
+ */
+class INET_API TCPDCTCP : public TCPNewReno
+{
+  protected:
+    TCPDCTCPStateVariables *&state; // alias to TCPAlgorithm's 'state'
+
+    cOutVector *alphaVector; // will record dctcp_alpha
+
+    /** Create and return a TCPDCTCPStateVariables object. */
+    virtual TCPStateVariables *createStateVariables() {
+        return new TCPDCTCPStateVariables();
+    }
+
+    /** Updates alpha from the acked and ECE-marked bytes, and reduces cwnd on ECE */
+    virtual void processEcnFeedback(uint32 firstSeqAcked);
+
+  public:
+    /** Ctor */
+    TCPDCTCP();
+
+    /** Virtual dtor */
+    virtual ~TCPDCTCP();
+
+    /** Enables ECN on the connection */
+    virtual void initialize();
+
+    /** Starts the first observation window */
+    virtual void established(bool active);
+
+    /** Redefine what should happen when data got acked, to update alpha and react to ECE */
+    virtual void receivedDataAck(uint32 firstSeqAcked);
+};
+
+#endif
@@ -48,6 +48,13 @@ class INET_API TCPNewReno : public TCPTahoeRenoFamily
     /** Redefine what should happen on retransmission */
     virtual void processRexmitTimer(TCPEventCode& event);
 
+    /**
+     * Slow start and congestion avoidance on an ACK of new data outside
+     * Fast Recovery. Subclasses redefine it to change the window growth
+     * function but keep NewReno's loss recovery.
+     */
+    virtual void increaseCongestionWindow(uint32 firstSeqAcked);
+
   public:
     /** Ctor */
     TCPNewReno();
@@ -43,19 +43,20 @@ bool TCPByteStreamRcvQueue::Region::merge(const TCPVirtualDataRcvQueue::Region*
 
     if (nbegin != begin || nend != end)
     {
-        char *buff = new char[nend-nbegin];
+        // the merged content shares the chunks of both regions
+        ByteArray merged;
 
         if (nbegin != begin)
-            other->data.copyDataToBuffer(buff, begin - nbegin);
+            merged.addDataFromByteArray(other->data, 0, begin - nbegin);
 
-        data.copyDataToBuffer(buff + begin - nbegin, end - begin);
+        merged.addDataFromByteArray(data, 0, end - begin);
 
         if (nend != end)
-            other->data.copyDataToBuffer(buff + end - nbegin, nend - end);
+            merged.addDataFromByteArray(other->data, end - other->begin, nend - end);
 
         begin = nbegin;
         end = nend;
-        data.assignBuffer(buff, end - begin);
+        data = merged;
     }
 
     return true;
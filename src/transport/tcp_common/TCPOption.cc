@@ -0,0 +1,78 @@
+//
+// Copyright (C) 2004 Andras Varga
+// Copyright (C) 2009-2011 Thomas Reschka
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "TCPOption.h"
+
+
+Register_Class(TCPOption);
+
+TCPOption& TCPOption::operator=(const TCPOption& other)
+{
+    if (this == &other) return *this;
+    TCPOption_Base::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void TCPOption::copy(const TCPOption& other)
+{
+    numValues = other.numValues;
+    for (unsigned int i = 0; i < numValues; i++)
+        valuesArray[i] = other.valuesArray[i];
+}
+
+void TCPOption::parsimPack(cCommBuffer *b)
+{
+    TCPOption_Base::parsimPack(b);
+    b->pack(numValues);
+    b->pack(valuesArray, numValues);
+}
+
+void TCPOption::parsimUnpack(cCommBuffer *b)
+{
+    TCPOption_Base::parsimUnpack(b);
+    unsigned int size;
+    b->unpack(size);
+    setValuesArraySize(size);
+    b->unpack(valuesArray, numValues);
+}
+
+void TCPOption::setValuesArraySize(unsigned int size)
+{
+    if (size > MAX_TCPOPTION_VALUES)
+        throw cRuntimeError(this, "setValuesArraySize(%u): at most %u option values are supported", size, MAX_TCPOPTION_VALUES);
+
+    for (unsigned int i = numValues; i < size; i++)
+        valuesArray[i] = 0;
+    numValues = size;
+}
+
+unsigned int TCPOption::getValues(unsigned int k) const
+{
+    if (k >= numValues)
+        throw cRuntimeError("Array of size %d indexed by %d", numValues, k);
+    return valuesArray[k];
+}
+
+void TCPOption::setValues(unsigned int k, unsigned int value)
+{
+    if (k >= numValues)
+        throw cRuntimeError("Array of size %d indexed by %d", numValues, k);
+    valuesArray[k] = value;
+}
@@ -0,0 +1,60 @@
+//
+// Copyright (C) 2004 Andras Varga
+// Copyright (C) 2009-2011 Thomas Reschka
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef __INET_TCPOPTION_H
+#define __INET_TCPOPTION_H
+
+#include "INETDefs.h"
+#include "TCPOption_m.h"
+
+
+/**
+ * Represents a TCP header option. More info in the TCPOption.msg file.
+ *
+ * The option values are kept in a fixed-size array of MAX_TCPOPTION_VALUES
+ * elements, so TCPOption objects (and the options array of every copied
+ * TCPSegment) do not need a separate allocation for them.
+ */
+class INET_API TCPOption : public TCPOption_Base
+{
+  protected:
+    unsigned int numValues;
+    unsigned int valuesArray[MAX_TCPOPTION_VALUES];
+
+  private:
+    void copy(const TCPOption& other);
+
+  public:
+    TCPOption() : TCPOption_Base(), numValues(0) {}
+    TCPOption(const TCPOption& other) : TCPOption_Base(other) { copy(other); }
+    TCPOption& operator=(const TCPOption& other);
+    virtual TCPOption *dup() const {return new TCPOption(*this);}
+    virtual void parsimPack(cCommBuffer *b);
+    virtual void parsimUnpack(cCommBuffer *b);
+
+    /**
+     * Sets the number of values, at most MAX_TCPOPTION_VALUES.
+     * New values are initialized to zero.
+     */
+    virtual void setValuesArraySize(unsigned int size);
+    virtual unsigned int getValuesArraySize() const {return numValues;}
+    virtual unsigned int getValues(unsigned int k) const;
+    virtual void setValues(unsigned int k, unsigned int value);
+};
+
+#endif
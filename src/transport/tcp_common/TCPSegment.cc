@@ -52,6 +52,63 @@ std::string Sack::str() const
 
 Register_Class(TCPSegment);
 
+// Pool of storage blocks of deleted TCPSegment objects (singly linked through
+// the blocks themselves), reused by TCPSegment::operator new.
+struct TCPSegmentPoolBlock
+{
+    TCPSegmentPoolBlock *next;
+};
+static TCPSegmentPoolBlock *segmentPool = NULL;
+static unsigned int segmentPoolSize = 0;
+static const unsigned int MAX_SEGMENT_POOL_SIZE = 1024;
+
+// the pool outlives simulation runs (it is bounded), and is freed at shutdown
+EXECUTE_ON_SHUTDOWN(TCPSegment::releasePool());
+
+void *TCPSegment::operator new(size_t size)
+{
+    // subclasses have a different size, they are not pooled
+    if (size != sizeof(TCPSegment) || segmentPool == NULL)
+        return ::operator new(size);
+
+    TCPSegmentPoolBlock *block = segmentPool;
+    segmentPool = block->next;
+    segmentPoolSize--;
+    return block;
+}
+
+void TCPSegment::operator delete(void *ptr, size_t size)
+{
+    if (ptr == NULL)
+        return;
+
+    if (size != sizeof(TCPSegment) || segmentPoolSize >= MAX_SEGMENT_POOL_SIZE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    TCPSegmentPoolBlock *block = (TCPSegmentPoolBlock *)ptr;
+    block->next = segmentPool;
+    segmentPool = block;
+    segmentPoolSize++;
+}
+
+void TCPSegment::releasePool()
+{
+    while (segmentPool)
+    {
+        TCPSegmentPoolBlock *block = segmentPool;
+        segmentPool = block->next;
+        ::operator delete(block);
+    }
+    segmentPoolSize = 0;
+}
+
+unsigned int TCPSegment::getPoolSize()
+{
+    return segmentPoolSize;
+}
 
 uint32_t TCPSegment::getSegLen()
 {
@@ -109,6 +166,7 @@ TCPSegment& TCPSegment::operator=(const TCPSegment& other)
 
 void TCPSegment::copy(const TCPSegment& other)
 {
+    payloadList.reserve(other.payloadList.size());
     for (PayloadList::const_iterator i = other.payloadList.begin(); i != other.payloadList.end(); ++i)
         addPayloadMessage(i->msg->dup(), i->endSequenceNo);
 }
@@ -120,12 +178,9 @@ TCPSegment::~TCPSegment()
 
 void TCPSegment::clean()
 {
-    while (!payloadList.empty())
-    {
-        cPacket *msg = payloadList.front().msg;
-        payloadList.pop_front();
-        dropAndDelete(msg);
-    }
+    for (PayloadList::iterator i = payloadList.begin(); i != payloadList.end(); ++i)
+        dropAndDelete(i->msg);
+    payloadList.clear();
 }
 
 void TCPSegment::truncateData(unsigned int truncleft, unsigned int truncright)
@@ -135,12 +190,13 @@ void TCPSegment::truncateData(unsigned int truncleft, unsigned int truncright)
     if (0 != byteArray_var.getDataArraySize())
         byteArray_var.truncateData(truncleft, truncright);
 
-    while (!payloadList.empty() && (payloadList.front().endSequenceNo - sequenceNo_var) <= truncleft)
+    PayloadList::iterator i = payloadList.begin();
+    while (i != payloadList.end() && (i->endSequenceNo - sequenceNo_var) <= truncleft)
     {
-        cPacket *msg = payloadList.front().msg;
-        payloadList.pop_front();
-        dropAndDelete(msg);
+        dropAndDelete(i->msg);
+        ++i;
     }
+    payloadList.erase(payloadList.begin(), i);
 
 
     sequenceNo_var += truncleft;
@@ -180,10 +236,7 @@ unsigned int TCPSegment::getPayloadArraySize() const
 
 TCPPayloadMessage& TCPSegment::getPayload(unsigned int k)
 {
-    PayloadList::iterator i = payloadList.begin();
-    while (k>0 && i!=payloadList.end())
-        (++i, --k);
-    return *i;
+    return payloadList.at(k);
 }
 
 void TCPSegment::setPayload(unsigned int k, const TCPPayloadMessage& payload_var)
@@ -208,7 +261,7 @@ cPacket *TCPSegment::removeFirstPayloadMessage(uint32& endSequenceNo)
 
     cPacket *msg = payloadList.front().msg;
     endSequenceNo = payloadList.front().endSequenceNo;
-    payloadList.pop_front();
+    payloadList.erase(payloadList.begin());
     drop(msg);
     return msg;
 }
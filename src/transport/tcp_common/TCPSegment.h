@@ -19,7 +19,7 @@
 #ifndef __INET_TCPSEGMENT_H
 #define __INET_TCPSEGMENT_H
 
-#include <list>
+#include <vector>
 #include "INETDefs.h"
 #include "TCPSegment_m.h"
 
@@ -58,7 +58,9 @@ class Sack : public Sack_Base
 class INET_API TCPSegment : public TCPSegment_Base
 {
   protected:
-    typedef std::list<TCPPayloadMessage> PayloadList;
+    // a segment rarely carries more than one or two payload messages,
+    // a vector needs a single allocation for them (and none when empty)
+    typedef std::vector<TCPPayloadMessage> PayloadList;
     PayloadList payloadList;
 
   private:
@@ -74,6 +76,18 @@ class INET_API TCPSegment : public TCPSegment_Base
     virtual void parsimPack(cCommBuffer *b);
     virtual void parsimUnpack(cCommBuffer *b);
 
+    /** @name Storage of deleted segments is kept in a pool and reused for new ones */
+    //@{
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr, size_t size);
+
+    /** Frees the pooled storage; called at shutdown */
+    static void releasePool();
+
+    /** Returns the number of storage blocks in the pool */
+    static unsigned int getPoolSize();
+    //@}
+
     /** Generated but unused method, should not be called. */
     virtual void setPayloadArraySize(unsigned int size);
 
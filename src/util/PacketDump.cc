@@ -632,6 +632,7 @@ void PacketDump::tcpDump(bool l2r, const char *label, TCPSegment *tcpseg,
     if (tcpseg->getRstBit()) {flags = true; out << "R ";}
     if (tcpseg->getSynBit()) {flags = true; out << "S ";}
     if (tcpseg->getFinBit()) {flags = true; out << "F ";}
+    if (tcpseg->getEceBit()) {flags = true; out << "E ";}
     if (!flags) {out << ". ";}
 
     // data-seqno
@@ -74,6 +74,8 @@ int TCPSerializer::serialize(const TCPSegment *tcpseg,
         flags |= TH_ACK;
     if (tcpseg->getUrgBit())
         flags |= TH_URG;
+    if (tcpseg->getEceBit())
+        flags |= TH_ECE;
     tcp->th_flags = (TH_FLAGS & flags);
     tcp->th_win = htons(tcpseg->getWindow());
     tcp->th_urp = htons(tcpseg->getUrgentPointer());
@@ -172,6 +174,7 @@ void TCPSerializer::parse(const unsigned char *buf, unsigned int bufsize, TCPSeg
     tcpseg->setPshBit((flags & TH_PUSH) == TH_PUSH);
     tcpseg->setAckBit((flags & TH_ACK) == TH_ACK);
     tcpseg->setUrgBit((flags & TH_URG) == TH_URG);
+    tcpseg->setEceBit((flags & TH_ECE) == TH_ECE);
 
     tcpseg->setWindow(ntohs(tcp->th_win));
     // Checksum (header checksum): modelled by cMessage::hasBitError()
@@ -201,6 +204,11 @@ void TCPSerializer::parse(const unsigned char *buf, unsigned int bufsize, TCPSeg
                     break;
             } // switch
 
+            // a zero length or an option running past the header is malformed:
+            // ignore the rest of the option list instead of reading past it
+            if (length == 0 || j + length > optionBytes)
+                break;
+
             // kind
             tmpOption.setKind(kind);
             // length
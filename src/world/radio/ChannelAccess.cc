@@ -86,6 +86,9 @@ void ChannelAccess::initialize(int stage)
 
         myRadioRef = cc->registerRadio(this);
         cc->setRadioPosition(myRadioRef, radioPos);
+        if (mobility)
+            cc->setRadioMobility(myRadioRef, mobility);
+        queryPosition = cc->isRadioPositionQueried();
     }
 }
 
@@ -112,11 +115,18 @@ void ChannelAccess::sendToChannel(AirFrame *msg)
     cc->sendToChannel(myRadioRef, msg);
 }
 
+const Coord& ChannelAccess::getRadioPosition()
+{
+    if (queryPosition && mobility)
+        radioPos = mobility->getCurrentPosition();
+    return radioPos;
+}
+
 void ChannelAccess::receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj)
 {
     if (signalID == mobilityStateChangedSignal)
     {
-        IMobility *mobility = check_and_cast<IMobility*>(obj);
+        mobility = check_and_cast<IMobility*>(obj);
         radioPos = mobility->getCurrentPosition();
         positionUpdateArrived = true;
 
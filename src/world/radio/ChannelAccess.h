@@ -31,6 +31,7 @@
 
 // Forward declarations
 class AirFrame;
+class IMobility;
 
 /**
  * @brief Basic class for all physical layers, please don't touch!!
@@ -59,9 +60,11 @@ class INET_API ChannelAccess : public BasicModule, protected cListener
     cModule *hostModule;    // the host that contains this radio model
     Coord radioPos;  // the physical position of the radio (derived from display string or from mobility models)
     bool positionUpdateArrived;
+    IMobility *mobility;  // the mobility module that sent the last position update, or NULL
+    bool queryPosition;  // if true, getRadioPosition() queries the current position from the mobility module
 
   public:
-    ChannelAccess() : cc(NULL), myRadioRef(NULL), hostModule(NULL) {}
+    ChannelAccess() : cc(NULL), myRadioRef(NULL), hostModule(NULL), mobility(NULL), queryPosition(false) {}
     virtual ~ChannelAccess();
 
     /**
@@ -79,7 +82,13 @@ class INET_API ChannelAccess : public BasicModule, protected cListener
     virtual void sendToChannel(AirFrame *msg);
 
     virtual cPar& getChannelControlPar(const char *parName) { return dynamic_cast<cModule *>(cc)->par(parName); }
+
+    /** Returns the position of the radio; queries the mobility module if queryPosition is set */
+    const Coord& getRadioPosition();
+
+    /** Returns the position of the radio as of the last position update */
     const Coord& getRadioPosition() const { return radioPos; }
+
     cModule *getHostModule() const { return hostModule; }
 
     /** Register with ChannelControl and subscribe to hostPos*/
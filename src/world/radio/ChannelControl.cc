@@ -17,6 +17,7 @@
 
 #include "ChannelControl.h"
 #include "FWMath.h"
+#include "IMobility.h"
 #include <cassert>
 
 #include "AirFrame_m.h"
@@ -65,11 +66,14 @@ void ChannelControl::initialize()
     numChannels = par("numChannels");
     transmissions.resize(numChannels);
 
+    queryRadioPositions = par("queryRadioPositions");
+
     lastOngoingTransmissionsUpdate = 0;
 
     maxInterferenceDistance = calcInterfDist();
 
     WATCH(maxInterferenceDistance);
+    WATCH(queryRadioPositions);
     WATCH_LIST(radios);
     WATCH_VECTOR(transmissions);
 }
@@ -123,6 +127,7 @@ ChannelControl::RadioRef ChannelControl::registerRadio(cModule *radio, cGate *ra
     re.radioModule = radio;
     re.radioInGate = radioInGate->getPathStartGate();
     re.isNeighborListValid = false;
+    re.mobility = NULL;
     re.channel = 0;  // for now
     re.isActive = true;
     radios.push_back(re);
@@ -177,6 +182,29 @@ const ChannelControl::RadioRefVector& ChannelControl::getNeighbors(RadioRef h)
     return h->neighborList;
 }
 
+const ChannelControl::RadioRefVector& ChannelControl::getRadiosInRange(RadioRef h)
+{
+    queryRadioPosition(h);
+    double maxDistSquared = maxInterferenceDistance * maxInterferenceDistance;
+    radiosInRange.clear();
+    for (RadioList::iterator it = radios.begin(); it != radios.end(); ++it)
+    {
+        RadioEntry *hi = &(*it);
+        if (hi == h)
+            continue;
+        queryRadioPosition(hi);
+        if (h->pos.sqrdist(hi->pos) < maxDistSquared)
+            radiosInRange.push_back(hi);
+    }
+    return radiosInRange;
+}
+
+void ChannelControl::queryRadioPosition(RadioRef r)
+{
+    if (r->mobility)
+        r->pos = r->mobility->getCurrentPosition();
+}
+
 void ChannelControl::updateConnections(RadioRef h)
 {
     Coord& hpos = h->pos;
@@ -222,7 +250,14 @@ void ChannelControl::setRadioPosition(RadioRef r, const Coord& pos)
 {
     Enter_Method_Silent();
     r->pos = pos;
-    updateConnections(r);
+    if (!queryRadioPositions)
+        updateConnections(r);
+}
+
+void ChannelControl::setRadioMobility(RadioRef r, IMobility *mobility)
+{
+    Enter_Method_Silent();
+    r->mobility = mobility;
 }
 
 void ChannelControl::setRadioChannel(RadioRef r, int channel)
@@ -292,7 +327,7 @@ void ChannelControl::sendToChannel(RadioRef srcRadio, AirFrame *airFrame)
     // NOTE: no Enter_Method()! We pretend this method is part of ChannelAccess
 
     // loop through all radios in range
-    const RadioRefVector& neighbors = getNeighbors(srcRadio);
+    const RadioRefVector& neighbors = queryRadioPositions ? getRadiosInRange(srcRadio) : getNeighbors(srcRadio);
     int n = neighbors.size();
     int channel = airFrame->getChannelNumber();
     for (int i=0; i<n; i++)
@@ -40,6 +40,7 @@ struct IChannelControl::RadioEntry {
     cGate *radioInGate;  // gate on host module used to receive airframes
     int channel;
     Coord pos; // cached radio position
+    IMobility *mobility; // mobility module of the host, or NULL; used if positions are queried
 
     struct Compare {
         bool operator() (const RadioRef &lhs, const RadioRef &rhs) const {
@@ -91,6 +92,16 @@ class INET_API ChannelControl : public cSimpleModule, public IChannelControl
     /** the number of controlled channels */
     int numChannels;
 
+    /**
+     * if true, positions are queried from the mobility modules at transmission
+     * time and the receivers are selected by distance, instead of maintaining
+     * neighbor lists on every mobility state change
+     */
+    bool queryRadioPositions;
+
+    /** receivers of the current transmission if queryRadioPositions is set */
+    RadioRefVector radiosInRange;
+
   protected:
     virtual void updateConnections(RadioRef h);
 
@@ -109,6 +120,12 @@ class INET_API ChannelControl : public cSimpleModule, public IChannelControl
     /** Get the list of modules in range of the given host */
     virtual const RadioRefVector& getNeighbors(RadioRef h);
 
+    /** Get the list of modules in range of the given host from their current positions (queryRadioPositions mode) */
+    virtual const RadioRefVector& getRadiosInRange(RadioRef h);
+
+    /** Updates the cached position of the radio from its mobility module, if it has one */
+    virtual void queryRadioPosition(RadioRef r);
+
     /** Notifies the channel control with an ongoing transmission */
     virtual void addOngoingTransmission(RadioRef h, AirFrame *frame);
 
@@ -137,6 +154,12 @@ class INET_API ChannelControl : public cSimpleModule, public IChannelControl
     /** To be called when the host moved; updates proximity info */
     virtual void setRadioPosition(RadioRef r, const Coord& pos);
 
+    /** Tells the mobility module of the host; needed if radio positions are queried */
+    virtual void setRadioMobility(RadioRef r, IMobility *mobility);
+
+    /** Returns the value of the queryRadioPositions parameter */
+    virtual bool isRadioPositionQueried() { return queryRadioPositions; }
+
     /** Called when host switches channel */
     virtual void setRadioChannel(RadioRef r, int channel);
 
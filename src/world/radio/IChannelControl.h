@@ -25,6 +25,7 @@
 
 // Forward declarations
 class AirFrame;
+class IMobility;
 
 /**
  * Interface to implement for a module that controls radio frequency channel access.
@@ -59,6 +60,15 @@ class INET_API IChannelControl
     /** To be called when the host moved; updates proximity info */
     virtual void setRadioPosition(RadioRef r, const Coord& pos) = 0;
 
+    /** Tells the mobility module of the host; needed if radio positions are queried */
+    virtual void setRadioMobility(RadioRef r, IMobility *mobility) = 0;
+
+    /**
+     * Returns true if radio positions are queried from the mobility modules
+     * when needed, instead of being tracked from mobility state changes.
+     */
+    virtual bool isRadioPositionQueried() = 0;
+
     /** Called when host switches channel */
     virtual void setRadioChannel(RadioRef r, int channel) = 0;
 
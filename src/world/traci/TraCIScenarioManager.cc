@@ -134,12 +134,12 @@ std::string TraCIScenarioManager::receiveTraCIMessage() {
     }
 
     uint32_t bufLength = msgLength - sizeof(msgLength);
-    char buf[bufLength];
+    std::string buf(bufLength, '\0'); // not on the stack: subscription results of many vehicles can be large
     {
         MYDEBUG << "Reading TraCI message of " << bufLength << " bytes" << endl;
         uint32_t bytesRead = 0;
         while (bytesRead < bufLength) {
-            int receivedBytes = ::recv(MYSOCKET, reinterpret_cast<char*>(&buf) + bytesRead, bufLength - bytesRead, 0);
+            int receivedBytes = ::recv(MYSOCKET, &buf[0] + bytesRead, bufLength - bytesRead, 0);
             if (receivedBytes > 0) {
                 bytesRead += receivedBytes;
             } else if (receivedBytes == 0) {
@@ -151,7 +151,7 @@ std::string TraCIScenarioManager::receiveTraCIMessage() {
             }
         }
     }
-    return std::string(buf, bufLength);
+    return buf;
 }
 
 void TraCIScenarioManager::sendTraCIMessage(std::string buf) {
@@ -203,6 +203,11 @@ TraCIScenarioManager::TraCIBuffer TraCIScenarioManager::queryTraCI(uint8_t comma
     sendTraCIMessage(makeTraCICommand(commandId, buf));
 
     TraCIBuffer obuf(receiveTraCIMessage());
+    checkTraCIResult(obuf, commandId);
+    return obuf;
+}
+
+void TraCIScenarioManager::checkTraCIResult(TraCIBuffer& obuf, uint8_t commandId) {
     uint8_t cmdLength; obuf >> cmdLength;
     uint8_t commandResp; obuf >> commandResp;
     ASSERT(commandResp == commandId);
@@ -211,7 +216,6 @@ TraCIScenarioManager::TraCIBuffer TraCIScenarioManager::queryTraCI(uint8_t comma
     if (result == RTYPE_NOTIMPLEMENTED) error("TraCI server reported command 0x%2x not implemented (\"%s\"). Might need newer version.", commandId, description.c_str());
     if (result == RTYPE_ERR) error("TraCI server reported error executing command 0x%2x (\"%s\").", commandId, description.c_str());
     ASSERT(result == RTYPE_OK);
-    return obuf;
 }
 
 TraCIScenarioManager::TraCIBuffer TraCIScenarioManager::queryTraCIOptional(uint8_t commandId, const TraCIBuffer& buf, bool& success, std::string* errorMsg) {
@@ -885,11 +889,12 @@ double TraCIScenarioManager::omnet2traciAngle(double angle) const {
     return angle;
 }
 
-void TraCIScenarioManager::subscribeToVehicleVariables(std::string vehicleId) {
-    // subscribe to some attributes of the vehicle
+void TraCIScenarioManager::subscribeToVehicleVariables(const std::set<std::string>& vehicleIds) {
+    if (vehicleIds.empty()) return;
+
+    // subscribe to some attributes of the vehicles
     uint32_t beginTime = 0;
     uint32_t endTime = 0x7FFFFFFF;
-    std::string objectId = vehicleId;
     uint8_t variableNumber = 5;
     uint8_t variable1 = VAR_POSITION;
     uint8_t variable2 = VAR_ROAD_ID;
@@ -897,19 +902,40 @@ void TraCIScenarioManager::subscribeToVehicleVariables(std::string vehicleId) {
     uint8_t variable4 = VAR_ANGLE;
     uint8_t variable5 = VAR_SIGNALS;
 
-    TraCIBuffer buf = queryTraCI(CMD_SUBSCRIBE_VEHICLE_VARIABLE, TraCIBuffer() << beginTime << endTime << objectId << variableNumber << variable1 << variable2 << variable3 << variable4 << variable5);
-    processSubcriptionResult(buf);
+    std::string msg;
+    for (std::set<std::string>::const_iterator i = vehicleIds.begin(); i != vehicleIds.end(); ++i) {
+        msg += makeTraCICommand(CMD_SUBSCRIBE_VEHICLE_VARIABLE, TraCIBuffer() << beginTime << endTime << *i << variableNumber << variable1 << variable2 << variable3 << variable4 << variable5);
+    }
+    sendTraCIMessage(msg);
+
+    // the reply holds a status response followed by a subscription result for each command
+    TraCIBuffer buf(receiveTraCIMessage());
+    for (size_t i = 0; i < vehicleIds.size(); ++i) {
+        checkTraCIResult(buf, CMD_SUBSCRIBE_VEHICLE_VARIABLE);
+        processSubcriptionResult(buf);
+    }
     ASSERT(buf.eof());
 }
 
-void TraCIScenarioManager::unsubscribeFromVehicleVariables(std::string vehicleId) {
-    // subscribe to some attributes of the vehicle
+void TraCIScenarioManager::unsubscribeFromVehicleVariables(const std::set<std::string>& vehicleIds) {
+    if (vehicleIds.empty()) return;
+
+    // unsubscribe from all attributes of the vehicles
     uint32_t beginTime = 0;
     uint32_t endTime = 0x7FFFFFFF;
-    std::string objectId = vehicleId;
     uint8_t variableNumber = 0;
 
-    TraCIBuffer buf = queryTraCI(CMD_SUBSCRIBE_VEHICLE_VARIABLE, TraCIBuffer() << beginTime << endTime << objectId << variableNumber);
+    std::string msg;
+    for (std::set<std::string>::const_iterator i = vehicleIds.begin(); i != vehicleIds.end(); ++i) {
+        msg += makeTraCICommand(CMD_SUBSCRIBE_VEHICLE_VARIABLE, TraCIBuffer() << beginTime << endTime << *i << variableNumber);
+    }
+    sendTraCIMessage(msg);
+
+    // the reply holds one status response per command
+    TraCIBuffer buf(receiveTraCIMessage());
+    for (size_t i = 0; i < vehicleIds.size(); ++i) {
+        checkTraCIResult(buf, CMD_SUBSCRIBE_VEHICLE_VARIABLE);
+    }
     ASSERT(buf.eof());
 }
 
@@ -943,12 +969,13 @@ void TraCIScenarioManager::processSimSubscription(std::string objectId, TraCIBuf
             ASSERT(varType == TYPE_STRINGLIST);
             uint32_t count; buf >> count;
             MYDEBUG << "TraCI reports " << count << " arrived vehicles." << endl;
+            std::set<std::string> needUnsubscribe;
             for (uint32_t i = 0; i < count; ++i) {
                 std::string idstring; buf >> idstring;
 
                 if (subscribedVehicles.find(idstring) != subscribedVehicles.end()) {
                     subscribedVehicles.erase(idstring);
-                    unsubscribeFromVehicleVariables(idstring);
+                    needUnsubscribe.insert(idstring);
                 }
 
                 // check if this object has been deleted already (e.g. because it was outside the ROI)
@@ -960,6 +987,7 @@ void TraCIScenarioManager::processSimSubscription(std::string objectId, TraCIBuf
                 }
 
             }
+            unsubscribeFromVehicleVariables(needUnsubscribe);
 
             if ((count > 0) && (count >= activeVehicleCount) && autoShutdown) autoShutdownTriggered = true;
             activeVehicleCount -= count;
@@ -1015,18 +1043,16 @@ void TraCIScenarioManager::processVehicleSubscription(std::string objectId, TraC
             // check for vehicles that need subscribing to
             std::set<std::string> needSubscribe;
             std::set_difference(drivingVehicles.begin(), drivingVehicles.end(), subscribedVehicles.begin(), subscribedVehicles.end(), std::inserter(needSubscribe, needSubscribe.begin()));
-            for (std::set<std::string>::const_iterator i = needSubscribe.begin(); i != needSubscribe.end(); ++i) {
-                subscribedVehicles.insert(*i);
-                subscribeToVehicleVariables(*i);
-            }
+            subscribedVehicles.insert(needSubscribe.begin(), needSubscribe.end());
+            subscribeToVehicleVariables(needSubscribe);
 
             // check for vehicles that need unsubscribing from
             std::set<std::string> needUnsubscribe;
             std::set_difference(subscribedVehicles.begin(), subscribedVehicles.end(), drivingVehicles.begin(), drivingVehicles.end(), std::inserter(needUnsubscribe, needUnsubscribe.begin()));
             for (std::set<std::string>::const_iterator i = needUnsubscribe.begin(); i != needUnsubscribe.end(); ++i) {
                 subscribedVehicles.erase(*i);
-                unsubscribeFromVehicleVariables(*i);
             }
+            unsubscribeFromVehicleVariables(needUnsubscribe);
 
         } else if (variable1_resp == VAR_POSITION) {
             uint8_t varType; buf >> varType;
@@ -1123,17 +1149,16 @@ void TraCIScenarioManager::processSubcriptionResult(TraCIBuffer& buf) {
 template<> void TraCIScenarioManager::TraCIBuffer::write(std::string inv) {
     uint32_t length = inv.length();
     write<uint32_t> (length);
-    for (size_t i = 0; i < length; ++i) write<char> (inv[i]);
+    buf += inv;
 }
 
 template<> std::string TraCIScenarioManager::TraCIBuffer::read() {
     uint32_t length = read<uint32_t> ();
     if (length == 0) return std::string();
-    char obuf[length + 1];
+    if (length > buf.length() - buf_index) throw cRuntimeError("Attempted to read past end of byte buffer");
 
-    for (size_t i = 0; i < length; ++i) read<char> (obuf[i]);
-    obuf[length] = 0;
-
-    return std::string(obuf, length);
+    std::string obuf = buf.substr(buf_index, length);
+    buf_index += length;
+    return obuf;
 }
 
@@ -287,6 +287,11 @@ class INET_API TraCIScenarioManager : public cSimpleModule
          */
         TraCIBuffer queryTraCI(uint8_t commandId, const TraCIBuffer& buf = TraCIBuffer());
 
+        /**
+         * reads the status response of a single command, raises an error if it did not succeed
+         */
+        void checkTraCIResult(TraCIBuffer& obuf, uint8_t commandId);
+
         /**
          * sends a single command via TraCI, expects no reply, returns true if successful
          */
@@ -336,8 +341,11 @@ class INET_API TraCIScenarioManager : public cSimpleModule
          */
         double omnet2traciAngle(double angle) const;
 
-        void subscribeToVehicleVariables(std::string vehicleId);
-        void unsubscribeFromVehicleVariables(std::string vehicleId);
+        /**
+         * (un)subscribes to the vehicles' variables, sending one command per vehicle in a single TraCI message
+         */
+        void subscribeToVehicleVariables(const std::set<std::string>& vehicleIds);
+        void unsubscribeFromVehicleVariables(const std::set<std::string>& vehicleIds);
         void processSimSubscription(std::string objectId, TraCIBuffer& buf);
         void processVehicleSubscription(std::string objectId, TraCIBuffer& buf);
         void processSubcriptionResult(TraCIBuffer& buf);